@@ -1,23 +1,489 @@
 #include <iostream>
 #include <cmath>
 #include <stdexcept>
+#include <utility> // std::move, std::forward
+#include <type_traits> // Decidir cómo guarda cada nodo a sus operandos
+#include <array>   // Almacenamiento fijo de LAFixedVector
+#include <vector>  // Memoria externa para LAVectorView
+#include <thread>  // Operaciones en bloque repartidas entre núcleos
+#include <mutex>   // Cola de trozos del grupo de hilos
+#include <condition_variable>
+#include <algorithm> // Montículo acotado para los k vecinos más cercanos
+#include <limits>
+#include <cstdlib>   // rand() para inicializar k-means
+#include <chrono>    // Medir consultas por segundo
+#include <atomic>    // Modo determinista leído desde varios hilos
+
+// Intrínsecos SIMD (solo x86-64 con GCC/Clang; en otro caso se usa la versión escalar)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LA_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// ------------------------------------------------------
+// Plantillas de expresión (expression templates)
+// a + b, a - b y a * k NO calculan nada: devuelven un "nodo"
+// liviano que recuerda la operación. El cálculo ocurre en un solo
+// ciclo al asignar a un LAVector (o dentro de dot_product/magnitude),
+// así (v1 + v2) * 2.0 - v3 recorre la memoria una sola vez y no crea
+// vectores temporales.
+//
+// Cada nodo guarda por referencia los operandos con nombre (que deben
+// seguir vivos) y por valor los temporales: otros nodos, o un LAVector
+// temporal que se mueve adentro. Así 'auto x = (a + b) * 2.0;' es
+// seguro mientras a y b vivan.
+//
+// Un nodo también sirve donde antes se esperaba un LAVector:
+// (a + b).normalize(), .magnitude(), .dot_product(w) y .print() lo
+// evalúan primero; eval() da el LAVector explícitamente.
+// ------------------------------------------------------
+class LAVector;
+
+template <class E>
+struct LAExpr {
+    const E& self() const { return static_cast<const E&>(*this); }
+    int size() const { return self().size(); }
+    double operator[](int i) const { return self()[i]; }
+
+    // Definidos después de LAVector
+    LAVector eval() const;
+    LAVector normalize() const;
+    double magnitude() const;
+    template <class R>
+    double dot_product(const LAExpr<R>& rhs) const;
+    void print() const;
+};
+
+// true si T (sin referencias ni const) es una expresión
+template <class T>
+struct LAIsExpr {
+    typedef typename std::decay<T>::type D;
+    static const bool value = std::is_base_of<LAExpr<D>, D>::value;
+};
+
+// Cómo guarda un nodo a un operando recibido como T&&:
+// con nombre (T es una referencia) -> const &, temporal -> por valor
+template <class T>
+struct LAOperand {
+    typedef typename std::conditional<std::is_lvalue_reference<T>::value,
+                                      const typename std::decay<T>::type&,
+                                      typename std::decay<T>::type>::type type;
+};
+
+// Nodo: l + r
+template <class L, class R>
+struct LASum : LAExpr<LASum<L, R> > {
+    L l;
+    R r;
+    LASum(L lhs, R rhs) : l(std::move(lhs)), r(std::move(rhs)) {
+        if (l.size() != r.size()) throw std::invalid_argument("Dimensiones incompatibles para la suma.");
+    }
+    int size() const { return l.size(); }
+    double operator[](int i) const { return l[i] + r[i]; }
+};
+
+// Nodo: l - r
+template <class L, class R>
+struct LADiff : LAExpr<LADiff<L, R> > {
+    L l;
+    R r;
+    LADiff(L lhs, R rhs) : l(std::move(lhs)), r(std::move(rhs)) {
+        if (l.size() != r.size()) throw std::invalid_argument("Dimensiones incompatibles para la resta.");
+    }
+    int size() const { return l.size(); }
+    double operator[](int i) const { return l[i] - r[i]; }
+};
+
+// Nodo: e * escalar
+template <class E>
+struct LAScaled : LAExpr<LAScaled<E> > {
+    E e;
+    double scalar;
+    LAScaled(E expr, double s) : e(std::move(expr)), scalar(s) {}
+    int size() const { return e.size(); }
+    double operator[](int i) const { return e[i] * scalar; }
+};
+
+template <class L, class R,
+          class = typename std::enable_if<LAIsExpr<L>::value && LAIsExpr<R>::value>::type>
+LASum<typename LAOperand<L&&>::type, typename LAOperand<R&&>::type> operator+(L&& lhs, R&& rhs) {
+    return LASum<typename LAOperand<L&&>::type, typename LAOperand<R&&>::type>(
+        std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <class L, class R,
+          class = typename std::enable_if<LAIsExpr<L>::value && LAIsExpr<R>::value>::type>
+LADiff<typename LAOperand<L&&>::type, typename LAOperand<R&&>::type> operator-(L&& lhs, R&& rhs) {
+    return LADiff<typename LAOperand<L&&>::type, typename LAOperand<R&&>::type>(
+        std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+// Ejemplo: v * 2.0 → multiplica cada componente por 2.
+template <class E, class = typename std::enable_if<LAIsExpr<E>::value>::type>
+LAScaled<typename LAOperand<E&&>::type> operator*(E&& expr, double scalar) {
+    return LAScaled<typename LAOperand<E&&>::type>(std::forward<E>(expr), scalar);
+}
+
+template <class E, class = typename std::enable_if<LAIsExpr<E>::value>::type>
+LAScaled<typename LAOperand<E&&>::type> operator*(double scalar, E&& expr) {
+    return LAScaled<typename LAOperand<E&&>::type>(std::forward<E>(expr), scalar);
+}
+
+// -------- Producto punto entre expresiones --------
+// Evalúa ambas expresiones y multiplica en el mismo ciclo.
+// Se usan 4 acumuladores para no encadenar cada suma con la anterior.
+// Si los dos operandos ya están en memoria contigua (LAVector, o una
+// LAVectorView de salto 1) se usa el núcleo SIMD (ver LAKernels).
+class LAVectorView;
+inline double laDotKernel(const double* a, const double* b, int n);
+
+template <class T>
+struct LAIsLeaf {
+    static const bool value = std::is_same<T, LAVector>::value || std::is_same<T, LAVectorView>::value;
+};
+
+template <class L, class R>
+double dot_product(const LAExpr<L>& lhs, const LAExpr<R>& rhs) {
+    const L& a = lhs.self();
+    const R& b = rhs.self();
+    if (a.size() != b.size()) throw std::invalid_argument("Dimensiones incompatibles para producto punto.");
+    if constexpr (LAIsLeaf<L>::value && LAIsLeaf<R>::value) {
+        if (a.contiguous() && b.contiguous()) {
+            return laDotKernel(a.raw(), b.raw(), a.size());
+        }
+    }
+    int n = a.size();
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += a[i] * b[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+// -------- Magnitud de una expresión --------
+template <class E>
+double magnitude(const LAExpr<E>& expr) {
+    return std::sqrt(dot_product(expr, expr));
+}
+
+// ------------------------------------------------------
+// Núcleos SIMD para el producto punto (y por lo tanto la magnitud)
+// Un solo acumulador obliga a esperar cada suma antes de la siguiente;
+// aquí cada núcleo usa varios acumuladores vectoriales independientes.
+// Al arrancar se pregunta a la CPU (CPUID) qué instrucciones tiene y se
+// elige el mejor núcleo: AVX-512 > AVX2+FMA > SSE2 > escalar.
+//
+// Modo determinista: el resultado depende del orden de las sumas, que
+// cambia según el núcleo. Con set_deterministic(true) siempre se usa el
+// núcleo escalar de 8 acumuladores, que da el mismo resultado en cualquier CPU.
+// ------------------------------------------------------
+struct LAKernels {
+    typedef double (*DotKernel)(const double*, const double*, int);
+
+    // 8 acumuladores en orden fijo; también es el respaldo portable
+    static double dotScalar(const double* a, const double* b, int n) {
+        double s[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            for (int j = 0; j < 8; ++j) {
+                s[j] += a[i + j] * b[i + j];
+            }
+        }
+        for (; i < n; ++i) {
+            s[i & 7] += a[i] * b[i];
+        }
+        return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7]));
+    }
+
+#ifdef LA_X86_SIMD
+    // SSE2: 4 registros de 2 doubles = 8 sumas en paralelo
+    __attribute__((target("sse2")))
+    static double dotSSE2(const double* a, const double* b, int n) {
+        __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+        __m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+            s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+            s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_loadu_pd(a + i + 4), _mm_loadu_pd(b + i + 4)));
+            s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_loadu_pd(a + i + 6), _mm_loadu_pd(b + i + 6)));
+        }
+        __m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+        double lanes[2];
+        _mm_storeu_pd(lanes, s);
+        double result = lanes[0] + lanes[1];
+        for (; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    // AVX2 + FMA: 4 registros de 4 doubles = 16 sumas en paralelo
+    __attribute__((target("avx2,fma")))
+    static double dotAVX2(const double* a, const double* b, int n) {
+        __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+        __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            s0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), s0);
+            s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), s1);
+            s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), s2);
+            s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), s3);
+        }
+        __m256d s = _mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3));
+        double lanes[4];
+        _mm256_storeu_pd(lanes, s);
+        double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        for (; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    // AVX-512: 4 registros de 8 doubles = 32 sumas en paralelo
+    __attribute__((target("avx512f")))
+    static double dotAVX512(const double* a, const double* b, int n) {
+        __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+        __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            s0 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i), s0);
+            s1 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8), s1);
+            s2 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 16), _mm512_loadu_pd(b + i + 16), s2);
+            s3 = _mm512_fmadd_pd(_mm512_loadu_pd(a + i + 24), _mm512_loadu_pd(b + i + 24), s3);
+        }
+        __m512d s = _mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3));
+        double lanes[8];
+        _mm512_storeu_pd(lanes, s);
+        double result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+                      + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        for (; i < n; ++i) {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+#endif
+
+    // Elige el núcleo según la CPU (se llama una sola vez)
+    static DotKernel detect() {
+#ifdef LA_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return dotAVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return dotAVX2;
+        if (__builtin_cpu_supports("sse2")) return dotSSE2;
+#endif
+        return dotScalar;
+    }
+
+    static DotKernel& fastKernel() {
+        static DotKernel kernel = detect();
+        return kernel;
+    }
+
+    // Atómico: lo leen los hilos de LAThreads mientras otro hilo puede cambiarlo
+    static std::atomic<bool>& deterministicFlag() {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    static bool deterministic() {
+        return deterministicFlag().load(std::memory_order_relaxed);
+    }
+
+    static void set_deterministic(bool enabled) {
+        deterministicFlag().store(enabled, std::memory_order_relaxed);
+    }
+
+    // Nombre del núcleo en uso (útil para imprimir en pruebas)
+    static const char* name() {
+        if (deterministic()) return "escalar (determinista)";
+#ifdef LA_X86_SIMD
+        DotKernel k = fastKernel();
+        if (k == dotAVX512) return "AVX-512";
+        if (k == dotAVX2) return "AVX2+FMA";
+        if (k == dotSSE2) return "SSE2";
+#endif
+        return "escalar";
+    }
+
+    static double dot(const double* a, const double* b, int n) {
+        return deterministic() ? dotScalar(a, b, n) : fastKernel()(a, b, n);
+    }
+};
+
+inline double laDotKernel(const double* a, const double* b, int n) {
+    return LAKernels::dot(a, b, n);
+}
+
+// ------------------------------------------------------
+// Reparto de trabajo entre núcleos
+// run(n, grain, fn) parte [0, n) en trozos contiguos y llama fn(inicio, fin)
+// en varios hilos. Con menos de 'grain' elementos por hilo no vale la pena
+// repartir, así que todo corre en el hilo actual.
+// Los hilos se crean una sola vez (la primera vez que hacen falta) y luego
+// esperan trabajo: cada run() solo los despierta, sin crear ni esperar
+// (join) hilos. El hilo que llama también hace trozos. Un run() dentro de
+// un trozo corre en serie en ese hilo. 'fn' no debe lanzar excepciones.
+// ------------------------------------------------------
+struct LAThreads {
+    static int& maxThreads() {
+        static int count = std::thread::hardware_concurrency() > 0
+                         ? (int)std::thread::hardware_concurrency() : 1;
+        return count;
+    }
+
+    static void set_max_threads(int count) {
+        maxThreads() = count > 0 ? count : 1;
+    }
+
+    template <class F>
+    static void run(int n, int grain, F fn) {
+        int workers = maxThreads();
+        if (grain > 0 && n / grain < workers) workers = n / grain;
+        if (workers <= 1 || insideTask()) {
+            fn(0, n);
+            return;
+        }
+        pool().run(n, workers, &call<F>, &fn);
+    }
+
+private:
+    typedef void (*Task)(void* fn, int begin, int end);
+
+    template <class F>
+    static void call(void* fn, int begin, int end) {
+        (*static_cast<F*>(fn))(begin, end);
+    }
+
+    // true mientras este hilo está haciendo un trozo
+    static bool& insideTask() {
+        static thread_local bool inside = false;
+        return inside;
+    }
+
+    class Pool {
+    private:
+        std::mutex lock;
+        std::condition_variable wake;  // Hay trozos nuevos
+        std::condition_variable done;  // Se terminó el último trozo
+        std::mutex single;             // Un run() a la vez
+        int started;                   // Hilos creados hasta ahora
+        Task task;
+        void* context;
+        int total, chunk, chunks;      // El trabajo actual: [0, total) en 'chunks' trozos
+        int next;                      // Siguiente trozo sin dueño
+        int pending;                   // Trozos sin terminar
+
+        void work() {
+            insideTask() = true;
+            std::unique_lock<std::mutex> guard(lock);
+            while (true) {
+                wake.wait(guard, [this] { return next < chunks; });
+                takeChunks(guard);
+            }
+        }
+
+        // Hace trozos mientras queden; se llama con 'lock' tomado
+        void takeChunks(std::unique_lock<std::mutex>& guard) {
+            while (next < chunks) {
+                int begin = next++ * chunk;
+                int end = begin + chunk < total ? begin + chunk : total;
+                guard.unlock();
+                task(context, begin, end);
+                guard.lock();
+                if (--pending == 0) done.notify_all();
+            }
+        }
+
+    public:
+        Pool() : started(0), task(nullptr), context(nullptr),
+                 total(0), chunk(0), chunks(0), next(0), pending(0) {}
+
+        void run(int n, int workers, Task t, void* ctx) {
+            std::lock_guard<std::mutex> one(single);
+            std::unique_lock<std::mutex> guard(lock);
+            while (started < workers - 1) {
+                std::thread(&Pool::work, this).detach();
+                started++;
+            }
+            task = t;
+            context = ctx;
+            total = n;
+            chunk = (n + workers - 1) / workers;
+            chunks = (n + chunk - 1) / chunk;
+            next = 0;
+            pending = chunks;
+            wake.notify_all();
+            insideTask() = true;
+            takeChunks(guard);
+            insideTask() = false;
+            done.wait(guard, [this] { return pending == 0; });
+        }
+    };
+
+    // Nunca se destruye: sus hilos viven lo mismo que el proceso
+    static Pool& pool() {
+        static Pool* instance = new Pool();
+        return *instance;
+    }
+};
 
 // ------------------------------------------------------
 // Clase: LAVector
 // Representa un vector matemático en el contexto del
 // álgebra lineal, NO un contenedor de datos como std::vector.
 // ------------------------------------------------------
-class LAVector {
+class LAVector : public LAExpr<LAVector> {
 private:
+    // Vectores de hasta 4 componentes (2D, 3D, 4D) se guardan dentro
+    // del propio objeto; solo los más grandes piden memoria con 'new'.
+    static const int INLINE_CAPACITY = 4;
+
     int dim;          // Dimensión del vector (ej. 2D, 3D, nD)
-    double* data;     // Arreglo dinámico que guarda los componentes
+    double* data;     // Apunta a 'inlineData' o a un arreglo dinámico
+    double inlineData[INLINE_CAPACITY];
+
+    // Deja 'data' listo para 'n' componentes (sin inicializar)
+    void allocate(int n) {
+        dim = n;
+        data = n <= INLINE_CAPACITY ? inlineData : new double[n];
+    }
+
+    // Libera el arreglo dinámico (si lo hay) y queda vacío
+    void release() {
+        if (data != inlineData) delete[] data;
+        data = inlineData;
+        dim = 0;
+    }
+
+    // Toma el contenido de 'other' (robando su arreglo si es dinámico)
+    void steal(LAVector& other) {
+        if (other.data == other.inlineData) {
+            allocate(other.dim);
+            for (int i = 0; i < dim; ++i) {
+                data[i] = other.data[i];
+            }
+        } else {
+            dim = other.dim;
+            data = other.data;
+        }
+        other.data = other.inlineData;
+        other.dim = 0;
+    }
 
 public:
     // -------- Constructor normal --------
     // Crea un vector de dimensión 'dimension' con valores iniciales.
-    LAVector(int dimension, double init_value = 0.0) : dim(dimension) {
-        if (dim <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
-        data = new double[dim];
+    LAVector(int dimension, double init_value = 0.0) {
+        if (dimension <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
+        allocate(dimension);
         for (int i = 0; i < dim; ++i) {
             data[i] = init_value; // Inicializamos con el valor dado
         }
@@ -25,8 +491,8 @@ public:
 
     // -------- Constructor con lista de inicialización --------
     // Ejemplo: LAVector v = {1.0, 2.0, 3.0};
-    LAVector(std::initializer_list<double> values) : dim(values.size()) {
-        data = new double[dim];
+    LAVector(std::initializer_list<double> values) {
+        allocate((int)values.size());
         int i = 0;
         for (double val : values) {
             data[i++] = val;
@@ -35,92 +501,206 @@ public:
 
     // -------- Constructor de copia --------
     // Se usa cuando creamos un nuevo vector a partir de otro existente.
-    LAVector(const LAVector& other) : dim(other.dim) {
-        data = new double[dim];
+    LAVector(const LAVector& other) {
+        allocate(other.dim);
         for (int i = 0; i < dim; ++i) {
             data[i] = other.data[i];
         }
     }
 
+    // -------- Constructor desde una expresión --------
+    // Ejemplo: LAVector w = (v1 + v2) * 2.0;
+    // Un solo 'new' y un solo ciclo que evalúa toda la expresión.
+    template <class E>
+    LAVector(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        allocate(e.size());
+        for (int i = 0; i < dim; ++i) {
+            data[i] = e[i];
+        }
+    }
+
+    // -------- Constructor de movimiento --------
+    // Se "roba" el arreglo de un temporal en vez de copiarlo
+    // (si es pequeño y vive dentro del objeto, se copian sus componentes).
+    // El vector de origen queda vacío (dim = 0).
+    LAVector(LAVector&& other) noexcept {
+        steal(other);
+    }
+
     // -------- Destructor --------
     // Libera la memoria dinámica usada por el arreglo data.
     ~LAVector() {
-        delete[] data;
+        release();
     }
 
     // -------- Operador de asignación (=) --------
     // Permite hacer: v1 = v2;
+    // Si la dimensión coincide se reutiliza el arreglo actual.
     LAVector& operator=(const LAVector& other) {
         if (this == &other) return *this; // Evita auto-asignación
-        delete[] data;
-
-        dim = other.dim;
-        data = new double[dim];
+        if (dim != other.dim) {
+            release();
+            allocate(other.dim);
+        }
         for (int i = 0; i < dim; ++i) {
             data[i] = other.data[i];
         }
         return *this;
     }
 
-    // -------- Operador + (suma de vectores) --------
-    LAVector operator+(const LAVector& rhs) const {
-        if (dim != rhs.dim) throw std::invalid_argument("Dimensiones incompatibles para la suma.");
-        LAVector result(dim);
+    // -------- Asignación por movimiento --------
+    // Permite hacer: v1 = std::move(v2); sin copiar el arreglo.
+    LAVector& operator=(LAVector&& other) noexcept {
+        if (this == &other) return *this;
+        release();
+        steal(other);
+        return *this;
+    }
+
+    // -------- Asignación desde una expresión --------
+    // Ejemplo: acc = acc + x * 2.0;
+    // Si la dimensión coincide se reutiliza el arreglo actual (sin 'new').
+    // Es seguro aunque la expresión use a este mismo vector: cada
+    // componente i solo lee la posición i antes de escribirla.
+    template <class E>
+    LAVector& operator=(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        if (e.size() == dim) {
+            for (int i = 0; i < dim; ++i) {
+                data[i] = e[i];
+            }
+            return *this;
+        }
+        // Dimensión distinta: se evalúa aparte antes de soltar el
+        // arreglo viejo, por si la expresión lo está leyendo.
+        int n = e.size();
+        if (n <= INLINE_CAPACITY) {
+            double temp[INLINE_CAPACITY];
+            for (int i = 0; i < n; ++i) {
+                temp[i] = e[i];
+            }
+            release();
+            allocate(n);
+            for (int i = 0; i < n; ++i) {
+                data[i] = temp[i];
+            }
+        } else {
+            double* fresh = new double[n];
+            for (int i = 0; i < n; ++i) {
+                fresh[i] = e[i];
+            }
+            release();
+            dim = n;
+            data = fresh;
+        }
+        return *this;
+    }
+
+    // -------- Operaciones en el lugar (sin 'new') --------
+    // acc += x * a; recorre acc una sola vez y no crea temporales.
+    // Como en la asignación desde expresión, la expresión puede usar a
+    // este mismo vector (ej. v += v).
+    template <class E>
+    LAVector& operator+=(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        if (e.size() != dim) throw std::invalid_argument("Dimensiones incompatibles para la suma.");
         for (int i = 0; i < dim; ++i) {
-            result.data[i] = data[i] + rhs.data[i];
+            data[i] += e[i];
         }
-        return result;
+        return *this;
     }
 
-    // -------- Operador - (resta de vectores) --------
-    LAVector operator-(const LAVector& rhs) const {
-        if (dim != rhs.dim) throw std::invalid_argument("Dimensiones incompatibles para la resta.");
-        LAVector result(dim);
+    template <class E>
+    LAVector& operator-=(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        if (e.size() != dim) throw std::invalid_argument("Dimensiones incompatibles para la resta.");
         for (int i = 0; i < dim; ++i) {
-            result.data[i] = data[i] - rhs.data[i];
+            data[i] -= e[i];
         }
-        return result;
+        return *this;
     }
 
-    // -------- Operador * (multiplicación por escalar) --------
-    // Ejemplo: v * 2.0 → multiplica cada componente por 2.
-    LAVector operator*(double scalar) const {
-        LAVector result(dim);
+    LAVector& operator*=(double scalar) {
+        return scale(scalar);
+    }
+
+    // -------- Núcleos estilo BLAS nivel 1 --------
+    // scale: this = a * this
+    LAVector& scale(double a) {
         for (int i = 0; i < dim; ++i) {
-            result.data[i] = data[i] * scalar;
+            data[i] *= a;
         }
-        return result;
+        return *this;
     }
 
-    // -------- Producto punto (dot product) --------
-    // v1 · v2 = x1*x2 + y1*y2 + z1*z2 ...
-    double dot_product(const LAVector& rhs) const {
-        if (dim != rhs.dim) throw std::invalid_argument("Dimensiones incompatibles para producto punto.");
-        double result = 0.0;
+    // axpy: this = a * x + this (un solo redondeo por componente con fma)
+    template <class E>
+    LAVector& axpy(double a, const LAExpr<E>& x) {
+        const E& e = x.self();
+        if (e.size() != dim) throw std::invalid_argument("Dimensiones incompatibles para axpy.");
         for (int i = 0; i < dim; ++i) {
-            result += data[i] * rhs.data[i];
+            data[i] = std::fma(a, e[i], data[i]);
         }
-        return result;
+        return *this;
+    }
+
+    // axpby: this = a * x + b * this
+    template <class E>
+    LAVector& axpby(double a, const LAExpr<E>& x, double b) {
+        const E& e = x.self();
+        if (e.size() != dim) throw std::invalid_argument("Dimensiones incompatibles para axpby.");
+        for (int i = 0; i < dim; ++i) {
+            data[i] = std::fma(a, e[i], b * data[i]);
+        }
+        return *this;
+    }
+
+    // -------- Acceso a componentes --------
+    // Lo usan las plantillas de expresión para evaluar componente a componente.
+    int size() const { return dim; }
+    double operator[](int i) const { return data[i]; }
+    double& operator[](int i) { return data[i]; }
+    const double* raw() const { return data; }
+    bool contiguous() const { return true; }
+
+    // -------- Producto punto (dot product) --------
+    // v1 · v2 = x1*x2 + y1*y2 + z1*z2 ...
+    // Con otro LAVector o una vista contigua usa el núcleo SIMD elegido al
+    // arrancar (ver LAKernels); con una expresión la evalúa en el mismo
+    // ciclo. Nunca copia el otro operando a un LAVector temporal.
+    template <class E>
+    double dot_product(const LAExpr<E>& rhs) const {
+        return ::dot_product(*this, rhs);
     }
 
     // -------- Magnitud (norma Euclídea) --------
     // ||v|| = sqrt(x^2 + y^2 + z^2 ...)
     double magnitude() const {
-        double sum = 0.0;
-        for (int i = 0; i < dim; ++i) {
-            sum += data[i] * data[i];
-        }
-        return std::sqrt(sum);
+        return std::sqrt(LAKernels::dot(data, data, dim));
     }
 
     // -------- Normalización --------
     // Convierte el vector en unitario (magnitud = 1).
-    LAVector normalize() const {
+    LAVector normalize() const & {
         double mag = magnitude();
         if (mag == 0) throw std::runtime_error("No se puede normalizar un vector nulo.");
         return (*this) * (1.0 / mag);
     }
 
+    // Sobre un temporal (ej. (v1 + v2).normalize()) se escala en su lugar
+    LAVector normalize() && {
+        normalize_inplace();
+        return std::move(*this);
+    }
+
+    // Convierte este mismo vector en unitario, sin crear otro
+    LAVector& normalize_inplace() {
+        double mag = magnitude();
+        if (mag == 0) throw std::runtime_error("No se puede normalizar un vector nulo.");
+        return scale(1.0 / mag);
+    }
+
     // -------- Método de utilidad: imprimir --------
     void print() const {
         std::cout << "(";
@@ -133,35 +713,1697 @@ public:
 };
 
 // ------------------------------------------------------
-// Programa de prueba
+// Clase: LAFixedVector<N>
+// Vector de dimensión fija conocida al compilar (2D, 3D, 4D...).
+// - Los componentes viven en un std::array: nada de 'new'.
+// - Sumar un LAFixedVector<3> con uno <2> ni siquiera compila, así que
+//   no hace falta revisar dimensiones ni lanzar invalid_argument.
+// - Las operaciones son constexpr: con datos constantes se calculan al compilar.
+// (No se llama LAVector<N> porque LAVector ya es el nombre de la clase dinámica.)
 // ------------------------------------------------------
-int main() {
-    // Creamos dos vectores en R^3 (3D)
-    LAVector v1 = {1.0, 2.0, 3.0};
-    LAVector v2 = {4.0, 5.0, 6.0};
+template <int N>
+class LAFixedVector {
+    static_assert(N > 0, "La dimensión debe ser positiva.");
 
-    // Suma
-    LAVector suma = v1 + v2;
-    std::cout << "Suma: "; suma.print(); std::cout << std::endl;
+private:
+    std::array<double, N> data;
 
-    // Resta
-    LAVector resta = v1 - v2;
-    std::cout << "Resta: "; resta.print(); std::cout << std::endl;
+public:
+    // Todos los componentes con el mismo valor (0 por defecto)
+    constexpr explicit LAFixedVector(double init_value = 0.0) : data() {
+        for (int i = 0; i < N; ++i) {
+            data[i] = init_value;
+        }
+    }
 
-    // Multiplicación por escalar
-    LAVector escalar = v1 * 2.0;
-    std::cout << "Escalar (v1 * 2): "; escalar.print(); std::cout << std::endl;
+    // Ejemplo: LAFixedVector<3> v(1.0, 2.0, 3.0);
+    template <class... T>
+    constexpr LAFixedVector(double first, T... rest) : data{{first, (double)rest...}} {
+        static_assert(sizeof...(T) + 1 == N, "Cantidad de componentes distinta de N.");
+    }
 
-    // Producto punto
-    double dot = v1.dot_product(v2);
-    std::cout << "Producto punto (v1 · v2): " << dot << std::endl;
+    constexpr int size() const { return N; }
+    constexpr double operator[](int i) const { return data[i]; }
+    constexpr double& operator[](int i) { return data[i]; }
 
-    // Magnitud
-    std::cout << "Magnitud de v1: " << v1.magnitude() << std::endl;
+    constexpr LAFixedVector operator+(const LAFixedVector& rhs) const {
+        LAFixedVector result;
+        for (int i = 0; i < N; ++i) result.data[i] = data[i] + rhs.data[i];
+        return result;
+    }
 
-    // Normalización
-    LAVector v1_norm = v1.normalize();
-    std::cout << "Normalización de v1: "; v1_norm.print(); std::cout << std::endl;
+    constexpr LAFixedVector operator-(const LAFixedVector& rhs) const {
+        LAFixedVector result;
+        for (int i = 0; i < N; ++i) result.data[i] = data[i] - rhs.data[i];
+        return result;
+    }
+
+    constexpr LAFixedVector operator*(double scalar) const {
+        LAFixedVector result;
+        for (int i = 0; i < N; ++i) result.data[i] = data[i] * scalar;
+        return result;
+    }
+
+    constexpr double dot_product(const LAFixedVector& rhs) const {
+        double result = 0.0;
+        for (int i = 0; i < N; ++i) result += data[i] * rhs.data[i];
+        return result;
+    }
+
+    // std::sqrt no es constexpr, así que la magnitud se calcula en ejecución
+    double magnitude() const {
+        return std::sqrt(dot_product(*this));
+    }
+
+    LAFixedVector normalize() const {
+        double mag = magnitude();
+        if (mag == 0) throw std::runtime_error("No se puede normalizar un vector nulo.");
+        return (*this) * (1.0 / mag);
+    }
+
+    // Pasa a la clase dinámica (para mezclar con vectores de tamaño variable)
+    LAVector to_dynamic() const {
+        LAVector result(N);
+        for (int i = 0; i < N; ++i) result[i] = data[i];
+        return result;
+    }
+
+    void print() const {
+        std::cout << "(";
+        for (int i = 0; i < N; ++i) {
+            std::cout << data[i];
+            if (i < N - 1) std::cout << ", ";
+        }
+        std::cout << ")";
+    }
+};
+
+// -------- Miembros de LAExpr que necesitan a LAVector --------
+template <class E>
+LAVector LAExpr<E>::eval() const {
+    return LAVector(*this);
+}
+
+template <class E>
+LAVector LAExpr<E>::normalize() const {
+    return eval().normalize(); // Sobre el temporal: escala en su lugar
+}
+
+template <class E>
+double LAExpr<E>::magnitude() const {
+    return ::magnitude(*this);
+}
+
+template <class E>
+template <class R>
+double LAExpr<E>::dot_product(const LAExpr<R>& rhs) const {
+    return ::dot_product(*this, rhs);
+}
+
+template <class E>
+void LAExpr<E>::print() const {
+    eval().print();
+}
+
+
+// ------------------------------------------------------
+// Clase: LAVectorView
+// Vector que NO es dueño de su memoria: solo guarda (puntero,
+// dimensión, salto). Sirve para operar sobre un trozo de un arreglo
+// existente sin copiarlo: un rango, una columna de una matriz guardada
+// por filas (salto = número de columnas), un std::vector o una región
+// de memoria mapeada (mmap).
+// - Participa en las plantillas de expresión igual que LAVector, así que
+//   se pueden mezclar: LAVector w = view * 2.0 + v;
+// - Asignar a una vista escribe en la memoria original (no cambia el puntero).
+// - La memoria debe vivir más que la vista.
+// ------------------------------------------------------
+class LAVectorView : public LAExpr<LAVectorView> {
+private:
+    double* ptr;   // Primer componente
+    int dim;       // Cantidad de componentes
+    int stride;    // Distancia (en doubles) entre componentes consecutivos
+
+    void checkSize(int n) const {
+        if (n != dim) throw std::invalid_argument("Dimensiones incompatibles con la vista.");
+    }
+
+    // Revisa que el trozo quepa ANTES de calcular el puntero (un puntero
+    // fuera del arreglo ya es comportamiento indefinido, aunque no se lea)
+    static double* checkedStart(std::vector<double>& values, int offset, int dimension, int step) {
+        if (offset < 0 || dimension <= 0 || step <= 0
+            || offset + (long long)(dimension - 1) * step >= (long long)values.size()) {
+            throw std::out_of_range("La vista se sale del std::vector.");
+        }
+        return values.data() + offset;
+    }
+
+public:
+    // Sobre memoria cruda: componentes ptr[0], ptr[stride], ptr[2*stride]...
+    LAVectorView(double* data, int dimension, int step = 1)
+        : ptr(data), dim(dimension), stride(step) {
+        if (dim < 0) throw std::invalid_argument("La dimensión no puede ser negativa.");
+        if (step <= 0) throw std::invalid_argument("El salto de la vista debe ser positivo.");
+        if (dim > 0 && data == nullptr) throw std::invalid_argument("Vista sobre un puntero nulo.");
+    }
+
+    // Sobre todo un std::vector<double>
+    LAVectorView(std::vector<double>& values)
+        : ptr(values.data()), dim((int)values.size()), stride(1) {}
+
+    // Sobre un trozo de un std::vector<double> (revisa que quepa)
+    LAVectorView(std::vector<double>& values, int offset, int dimension, int step = 1)
+        : ptr(checkedStart(values, offset, dimension, step)), dim(dimension), stride(step) {}
+
+    // Sobre un LAVector (ver o modificar sus componentes sin copiarlas)
+    LAVectorView(LAVector& v)
+        : ptr(v.size() > 0 ? &v[0] : nullptr), dim(v.size()), stride(1) {}
+
+    // Copiar una vista copia el puntero (las dos ven la misma memoria)
+    LAVectorView(const LAVectorView& other) = default;
+
+    // -------- Asignación: escribe en la memoria original --------
+    // Cuidado: si dos vistas se solapan con distinto salto, el resultado
+    // puede leer componentes ya sobrescritos.
+    LAVectorView& operator=(const LAVectorView& other) {
+        return assign(other);
+    }
+
+    template <class E>
+    LAVectorView& operator=(const LAExpr<E>& expr) {
+        return assign(expr);
+    }
+
+    template <class E>
+    LAVectorView& assign(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        checkSize(e.size());
+        for (int i = 0; i < dim; ++i) {
+            ptr[(long long)i * stride] = e[i];
+        }
+        return *this;
+    }
+
+    // Sub-vista: 'n' componentes desde 'offset', tomando uno de cada 'step'
+    LAVectorView slice(int offset, int n, int step = 1) const {
+        if (offset < 0 || n <= 0 || step <= 0 || offset + (long long)(n - 1) * step >= dim) {
+            throw std::out_of_range("La sub-vista se sale de la vista.");
+        }
+        return LAVectorView(ptr + (long long)offset * stride, n, stride * step);
+    }
+
+    int size() const { return dim; }
+    int step() const { return stride; }
+    bool contiguous() const { return stride == 1; }
+    const double* raw() const { return ptr; }
+    double operator[](int i) const { return ptr[(long long)i * stride]; }
+    double& operator[](int i) { return ptr[(long long)i * stride]; }
+
+    // -------- Operaciones en el lugar (igual que en LAVector) --------
+    template <class E>
+    LAVectorView& operator+=(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        checkSize(e.size());
+        for (int i = 0; i < dim; ++i) {
+            (*this)[i] += e[i];
+        }
+        return *this;
+    }
+
+    template <class E>
+    LAVectorView& operator-=(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        checkSize(e.size());
+        for (int i = 0; i < dim; ++i) {
+            (*this)[i] -= e[i];
+        }
+        return *this;
+    }
+
+    LAVectorView& operator*=(double scalar) {
+        return scale(scalar);
+    }
+
+    LAVectorView& scale(double a) {
+        for (int i = 0; i < dim; ++i) {
+            (*this)[i] *= a;
+        }
+        return *this;
+    }
+
+    template <class E>
+    LAVectorView& axpy(double a, const LAExpr<E>& x) {
+        const E& e = x.self();
+        checkSize(e.size());
+        for (int i = 0; i < dim; ++i) {
+            (*this)[i] = std::fma(a, e[i], (*this)[i]);
+        }
+        return *this;
+    }
+
+    template <class E>
+    LAVectorView& axpby(double a, const LAExpr<E>& x, double b) {
+        const E& e = x.self();
+        checkSize(e.size());
+        for (int i = 0; i < dim; ++i) {
+            (*this)[i] = std::fma(a, e[i], b * (*this)[i]);
+        }
+        return *this;
+    }
+
+    // -------- Producto punto y magnitud --------
+    // Si ambos operandos son contiguos (vista de salto 1 o LAVector) se
+    // usa el núcleo SIMD de LAKernels.
+    template <class E>
+    double dot_product(const LAExpr<E>& rhs) const {
+        return ::dot_product(*this, rhs);
+    }
+
+    double magnitude() const {
+        return std::sqrt(dot_product(*this));
+    }
+
+    LAVectorView& normalize_inplace() {
+        double mag = magnitude();
+        if (mag == 0) throw std::runtime_error("No se puede normalizar un vector nulo.");
+        return scale(1.0 / mag);
+    }
+
+    // Copia normalizada (la vista original no cambia)
+    LAVector normalize() const {
+        LAVector result(*this);
+        return std::move(result.normalize_inplace());
+    }
+
+    void print() const {
+        std::cout << "(";
+        for (int i = 0; i < dim; ++i) {
+            std::cout << (*this)[i];
+            if (i < dim - 1) std::cout << ", ";
+        }
+        std::cout << ")";
+    }
+};
+
+// ------------------------------------------------------
+// Clase: LAVectorBatch
+// Guarda 'count' vectores de dimensión 'dim' en UN solo arreglo, en vez
+// de millones de LAVector con su propio 'new'. Dos formas de ordenarlos:
+// - LA_ROW_MAJOR: un vector tras otro (v0[0..d), v1[0..d), ...).
+//   Bueno para leer vectores completos.
+// - LA_SOA: componente por componente (todos los [0], luego todos los [1]...).
+//   Las operaciones en bloque avanzan por muchos vectores a la vez con
+//   lecturas contiguas, ideal para SIMD.
+// row(i) devuelve una LAVectorView del vector i, en cualquiera de las dos.
+// Las operaciones en bloque se reparten entre núcleos con LAThreads.
+// ------------------------------------------------------
+enum LABatchLayout {
+    LA_ROW_MAJOR,
+    LA_SOA
+};
+
+class LAVectorBatch {
+private:
+    int count;                  // Cantidad de vectores
+    int dim;                    // Dimensión de cada vector
+    LABatchLayout layout;
+    std::vector<double> values; // count * dim componentes
+
+    // Menos vectores que esto por hilo no compensa crear el hilo
+    static const int GRAIN = 4096;
+
+    // Posición del componente j del vector i
+    size_t index(int i, int j) const {
+        return layout == LA_ROW_MAJOR ? (size_t)i * dim + j : (size_t)j * count + i;
+    }
+
+    void checkQuery(int n) const {
+        if (n != dim) throw std::invalid_argument("La consulta no tiene la dimensión del lote.");
+    }
+
+public:
+    LAVectorBatch(int vectors, int dimension, LABatchLayout order = LA_ROW_MAJOR)
+        : count(vectors), dim(dimension), layout(order) {
+        if (count < 0 || dim <= 0) throw std::invalid_argument("Tamaño de lote inválido.");
+        values.assign((size_t)count * dim, 0.0);
+    }
+
+    int size() const { return count; }
+    int dimension() const { return dim; }
+    LABatchLayout order() const { return layout; }
+
+    double get(int i, int j) const { return values[index(i, j)]; }
+    double& at(int i, int j) { return values[index(i, j)]; }
+
+    // Vista (sin copia) del vector i; en LA_SOA el salto es 'count'
+    LAVectorView row(int i) {
+        if (i < 0 || i >= count) throw std::out_of_range("Vector fuera del lote.");
+        return layout == LA_ROW_MAJOR
+             ? LAVectorView(values.data() + (size_t)i * dim, dim, 1)
+             : LAVectorView(values.data() + i, dim, count);
+    }
+
+    // Copia una expresión (LAVector, vista, v1 + v2...) al vector i
+    template <class E>
+    void set(int i, const LAExpr<E>& expr) {
+        row(i).assign(expr);
+    }
+
+    // Arreglo crudo (para leerlo o llenarlo en bloque)
+    double* raw() { return values.data(); }
+    const double* raw() const { return values.data(); }
+
+    // -------- Producto punto de cada vector con 'query' --------
+    // out[i] = v_i · query
+    template <class E>
+    std::vector<double> dot(const LAExpr<E>& query) const {
+        const E& q = query.self();
+        checkQuery(q.size());
+        std::vector<double> qv(dim);
+        for (int j = 0; j < dim; ++j) qv[j] = q[j];
+        std::vector<double> out(count, 0.0);
+        dotInto(qv.data(), out.data());
+        return out;
+    }
+
+    // Igual que dot(), pero escribe en 'out' (count posiciones) sin pedir memoria
+    void dotInto(const double* q, double* out) const {
+        const double* base = values.data();
+        int n = count, d = dim;
+        if (layout == LA_ROW_MAJOR) {
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    out[i] = LAKernels::dot(base + (size_t)i * d, q, d);
+                }
+            });
+        } else {
+            // Por componente: el ciclo interno recorre vectores contiguos
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int i = begin; i < end; ++i) out[i] = 0.0;
+                for (int j = 0; j < d; ++j) {
+                    const double* column = base + (size_t)j * n;
+                    double qj = q[j];
+                    for (int i = begin; i < end; ++i) {
+                        out[i] += column[i] * qj;
+                    }
+                }
+            });
+        }
+    }
+
+    // -------- Magnitud de cada vector --------
+    std::vector<double> norms() const {
+        std::vector<double> out(count, 0.0);
+        const double* base = values.data();
+        double* res = out.data();
+        int n = count, d = dim;
+        if (layout == LA_ROW_MAJOR) {
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    const double* v = base + (size_t)i * d;
+                    res[i] = std::sqrt(LAKernels::dot(v, v, d));
+                }
+            });
+        } else {
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int j = 0; j < d; ++j) {
+                    const double* column = base + (size_t)j * n;
+                    for (int i = begin; i < end; ++i) {
+                        res[i] += column[i] * column[i];
+                    }
+                }
+                for (int i = begin; i < end; ++i) res[i] = std::sqrt(res[i]);
+            });
+        }
+        return out;
+    }
+
+    // -------- Normaliza todos los vectores --------
+    // A diferencia de LAVector::normalize(), los vectores nulos no lanzan
+    // excepción (en un lote grande uno solo no debería abortar todo): se dejan en cero.
+    void normalize_all() {
+        std::vector<double> inv = norms();
+        for (int i = 0; i < count; ++i) {
+            inv[i] = inv[i] > 0 ? 1.0 / inv[i] : 0.0;
+        }
+        double* base = values.data();
+        const double* scale = inv.data();
+        int n = count, d = dim;
+        if (layout == LA_ROW_MAJOR) {
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    double* v = base + (size_t)i * d;
+                    for (int j = 0; j < d; ++j) v[j] *= scale[i];
+                }
+            });
+        } else {
+            LAThreads::run(n, GRAIN, [=](int begin, int end) {
+                for (int j = 0; j < d; ++j) {
+                    double* column = base + (size_t)j * n;
+                    for (int i = begin; i < end; ++i) column[i] *= scale[i];
+                }
+            });
+        }
+    }
+
+    // -------- Suma por pares: v_i += other_i para todo i --------
+    // Con el mismo orden es una sola pasada sobre el arreglo completo.
+    LAVectorBatch& operator+=(const LAVectorBatch& other) {
+        if (other.count != count || other.dim != dim) {
+            throw std::invalid_argument("Lotes de distinto tamaño.");
+        }
+        double* dst = values.data();
+        if (other.layout == layout) {
+            const double* src = other.values.data();
+            long long total = (long long)count * dim;
+            int blocks = (int)((total + 1023) / 1024);
+            LAThreads::run(blocks, GRAIN / 64, [=](int begin, int end) {
+                long long from = (long long)begin * 1024;
+                long long to = (long long)end * 1024 < total ? (long long)end * 1024 : total;
+                for (long long k = from; k < to; ++k) dst[k] += src[k];
+            });
+        } else {
+            const LAVectorBatch* self = this;
+            const LAVectorBatch* src = &other;
+            LAThreads::run(count, GRAIN, [=](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    for (int j = 0; j < self->dim; ++j) dst[self->index(i, j)] += src->get(i, j);
+                }
+            });
+        }
+        return *this;
+    }
+};
+
+// ------------------------------------------------------
+// Búsqueda de los k vecinos más cercanos (k-NN)
+// - LAFlatIndex: fuerza bruta exacta. Un producto punto en bloque contra
+//   todo el lote (SIMD + hilos, ver LAVectorBatch::dotInto) y un MaxHeap
+//   de tamaño k que guarda los k mejores.
+// - LAIVFIndex: aproximada (IVF = índice de listas invertidas). k-means
+//   agrupa los vectores en 'nlist' listas; una consulta solo revisa las
+//   'nprobe' listas con centroide más cercano. Menos trabajo a cambio de
+//   perder algún vecino (ver la medición de "recall" en main).
+//
+// Distancias (menor = más parecido), usando solo productos punto:
+// - LA_L2:     ||v - q||^2 = ||v||^2 - 2 v·q + ||q||^2
+// - LA_COSINE: 1 - (v·q) / (||v|| ||q||)   (1 si alguno es nulo)
+// ------------------------------------------------------
+enum LAMetric {
+    LA_L2,
+    LA_COSINE
+};
+
+struct LANeighbor {
+    int index;       // Posición del vector en el lote
+    double distance;
+};
+
+inline double knn_distance(LAMetric metric, double dot, double normSq, double queryNormSq) {
+    if (metric == LA_L2) {
+        double d = normSq - 2.0 * dot + queryNormSq;
+        return d > 0.0 ? d : 0.0; // El redondeo puede dar un negativo diminuto
+    }
+    if (normSq == 0.0 || queryNormSq == 0.0) return 1.0;
+    double d = 1.0 - dot / (std::sqrt(normSq) * std::sqrt(queryNormSq));
+    return d > 0.0 ? d : 0.0;
+}
+
+// Los k vecinos más cercanos vistos hasta ahora (MaxHeap: arriba el peor)
+class LATopK {
+private:
+    int k;
+    std::vector<LANeighbor> heap;
+
+    // Orden total: por distancia y, en empate, por índice
+    static bool closer(const LANeighbor& a, const LANeighbor& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+    }
+
+public:
+    explicit LATopK(int limit) : k(limit > 0 ? limit : 0) {
+        heap.reserve(k);
+    }
+
+    // Ofrece un candidato; entra solo si mejora al peor de los k
+    void offer(int index, double distance) {
+        LANeighbor candidate = {index, distance};
+        if ((int)heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), closer);
+        } else if (k > 0 && closer(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), closer);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), closer);
+        }
+    }
+
+    // Resultado ordenado del más cercano al más lejano
+    std::vector<LANeighbor> sorted() const {
+        std::vector<LANeighbor> out = heap;
+        std::sort_heap(out.begin(), out.end(), closer);
+        return out;
+    }
+};
+
+// Copia una expresión a un arreglo contiguo (para los núcleos SIMD)
+template <class E>
+std::vector<double> knn_query(const LAExpr<E>& query, int dim) {
+    const E& q = query.self();
+    if (q.size() != dim) throw std::invalid_argument("La consulta no tiene la dimensión del índice.");
+    std::vector<double> out(dim);
+    for (int j = 0; j < dim; ++j) out[j] = q[j];
+    return out;
+}
+
+// -------- k-NN exacto por fuerza bruta --------
+// Guarda una referencia al lote: el lote debe vivir más que el índice.
+// search() reparte UNA consulta entre los hilos (conviene con lotes
+// grandes); search_batch() reparte las consultas, y cada una recorre el
+// lote en serie (conviene con muchas consultas).
+class LAFlatIndex {
+private:
+    const LAVectorBatch& batch;
+    LAMetric metric;
+    std::vector<double> normSq; // ||v_i||^2, calculado una vez al crear el índice
+
+    // 'q' contiguo de dimensión batch.dimension(); 'dots' con batch.size() posiciones
+    std::vector<LANeighbor> searchRaw(const double* q, int k, double* dots) const {
+        double qn = LAKernels::dot(q, q, batch.dimension());
+        batch.dotInto(q, dots);
+        LATopK best(k);
+        for (int i = 0; i < batch.size(); ++i) {
+            best.offer(i, knn_distance(metric, dots[i], normSq[i], qn));
+        }
+        return best.sorted();
+    }
+
+public:
+    LAFlatIndex(const LAVectorBatch& vectors, LAMetric m = LA_L2)
+        : batch(vectors), metric(m), normSq(vectors.norms()) {
+        for (size_t i = 0; i < normSq.size(); ++i) normSq[i] *= normSq[i];
+    }
+
+    template <class E>
+    std::vector<LANeighbor> search(const LAExpr<E>& query, int k) const {
+        std::vector<double> q = knn_query(query, batch.dimension());
+        std::vector<double> dots(batch.size());
+        return searchRaw(q.data(), k, dots.data());
+    }
+
+    // Resultado i = search(queries.row(i), k), con las consultas repartidas entre hilos
+    std::vector<std::vector<LANeighbor> > search_batch(const LAVectorBatch& queries, int k) const {
+        if (queries.dimension() != batch.dimension()) {
+            throw std::invalid_argument("Las consultas no tienen la dimensión del índice.");
+        }
+        std::vector<std::vector<LANeighbor> > out(queries.size());
+        std::vector<LANeighbor>* results = out.data();
+        const LAFlatIndex* self = this;
+        const LAVectorBatch* qs = &queries;
+        LAThreads::run(queries.size(), 1, [=](int begin, int end) {
+            int d = qs->dimension();
+            std::vector<double> q(d);
+            std::vector<double> dots(self->batch.size()); // Reutilizado por todas las consultas del trozo
+            for (int i = begin; i < end; ++i) {
+                for (int j = 0; j < d; ++j) q[j] = qs->get(i, j);
+                results[i] = self->searchRaw(q.data(), k, dots.data());
+            }
+        });
+        return out;
+    }
+};
+
+// -------- k-NN aproximado: IVF --------
+// Copia los vectores a sus listas (cada lista contigua, por filas), así
+// que no depende del lote después de construirse.
+class LAIVFIndex {
+private:
+    int dim;
+    LAMetric metric;
+    LAVectorBatch centroids;                   // nlist x dim, por filas
+    std::vector<double> centroidNormSq;
+    std::vector<std::vector<int> > ids;        // Índice original de cada vector de la lista
+    std::vector<std::vector<double> > lists;   // Vectores de cada lista, uno tras otro
+    std::vector<std::vector<double> > normSq;  // ||v||^2 de cada vector de la lista
+
+    void updateCentroidNorms() {
+        int nlist = centroids.size();
+        centroidNormSq.assign(nlist, 0.0);
+        for (int c = 0; c < nlist; ++c) {
+            const double* cv = centroids.raw() + (size_t)c * dim;
+            centroidNormSq[c] = LAKernels::dot(cv, cv, dim);
+        }
+    }
+
+    // Centroide más cercano (L2) a 'x'
+    int nearestCentroid(const double* x) const {
+        int best = 0;
+        double bestDist = std::numeric_limits<double>::infinity();
+        for (int c = 0; c < centroids.size(); ++c) {
+            // ||x||^2 es igual para todos los centroides, así que se omite
+            double d = centroidNormSq[c] - 2.0 * LAKernels::dot(centroids.raw() + (size_t)c * dim, x, dim);
+            if (d < bestDist) {
+                bestDist = d;
+                best = c;
+            }
+        }
+        return best;
+    }
+
+    // Asigna cada vector a su centroide más cercano (en paralelo)
+    void assignAll(const std::vector<double>& data, std::vector<int>& owner) const {
+        const double* base = data.data();
+        int* out = owner.data();
+        const LAIVFIndex* self = this;
+        int d = dim;
+        LAThreads::run((int)owner.size(), 256, [=](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                out[i] = self->nearestCentroid(base + (size_t)i * d);
+            }
+        });
+    }
+
+public:
+    /**
+     * Construye el índice con 'iterations' pasadas de k-means (Lloyd).
+     * Con LA_COSINE se agrupan los vectores normalizados.
+     */
+    LAIVFIndex(const LAVectorBatch& vectors, int nlist, LAMetric m = LA_L2, int iterations = 10)
+        : dim(vectors.dimension()), metric(m),
+          centroids(nlist < 1 ? 1 : (nlist > vectors.size() ? vectors.size() : nlist), vectors.dimension()) {
+        int n = vectors.size();
+        if (n == 0) throw std::invalid_argument("No se puede indexar un lote vacío.");
+        nlist = centroids.size();
+
+        // Copia por filas (y normalizada si la métrica es coseno)
+        std::vector<double> data((size_t)n * dim);
+        for (int i = 0; i < n; ++i) {
+            double* row = data.data() + (size_t)i * dim;
+            for (int j = 0; j < dim; ++j) row[j] = vectors.get(i, j);
+            if (metric == LA_COSINE) {
+                double mag = std::sqrt(LAKernels::dot(row, row, dim));
+                if (mag > 0) for (int j = 0; j < dim; ++j) row[j] /= mag;
+            }
+        }
+
+        // Centroides iniciales: 'nlist' vectores distintos al azar
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i) order[i] = i;
+        for (int c = 0; c < nlist; ++c) {
+            int pick = c + rand() % (n - c);
+            std::swap(order[c], order[pick]);
+            const double* src = data.data() + (size_t)order[c] * dim;
+            for (int j = 0; j < dim; ++j) centroids.at(c, j) = src[j];
+        }
+
+        // Lloyd: asignar al centroide más cercano y mover cada centroide al promedio
+        std::vector<int> owner(n, 0);
+        std::vector<double> sums((size_t)nlist * dim);
+        std::vector<int> members(nlist);
+        for (int it = 0; it < iterations; ++it) {
+            updateCentroidNorms();
+            assignAll(data, owner);
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(members.begin(), members.end(), 0);
+            for (int i = 0; i < n; ++i) {
+                const double* row = data.data() + (size_t)i * dim;
+                double* sum = sums.data() + (size_t)owner[i] * dim;
+                for (int j = 0; j < dim; ++j) sum[j] += row[j];
+                members[owner[i]]++;
+            }
+            for (int c = 0; c < nlist; ++c) {
+                if (members[c] == 0) continue; // Lista vacía: conserva su centroide
+                for (int j = 0; j < dim; ++j) {
+                    centroids.at(c, j) = sums[(size_t)c * dim + j] / members[c];
+                }
+            }
+        }
+        updateCentroidNorms();
+        assignAll(data, owner);
+
+        // Llenar las listas con los vectores originales
+        ids.assign(nlist, std::vector<int>());
+        lists.assign(nlist, std::vector<double>());
+        normSq.assign(nlist, std::vector<double>());
+        for (int i = 0; i < n; ++i) {
+            int c = owner[i];
+            ids[c].push_back(i);
+            double sq = 0.0;
+            for (int j = 0; j < dim; ++j) {
+                double x = vectors.get(i, j);
+                lists[c].push_back(x);
+                sq += x * x;
+            }
+            normSq[c].push_back(sq);
+        }
+    }
+
+    int list_count() const { return centroids.size(); }
+
+    // Revisa solo las 'nprobe' listas más cercanas a la consulta
+    template <class E>
+    std::vector<LANeighbor> search(const LAExpr<E>& query, int k, int nprobe) const {
+        std::vector<double> q = knn_query(query, dim);
+        double qn = LAKernels::dot(q.data(), q.data(), dim);
+
+        // Las listas se eligen con la consulta normalizada si la métrica es coseno
+        std::vector<double> probe = q;
+        if (metric == LA_COSINE && qn > 0) {
+            double inv = 1.0 / std::sqrt(qn);
+            for (int j = 0; j < dim; ++j) probe[j] *= inv;
+        }
+        int nlist = centroids.size();
+        if (nprobe > nlist) nprobe = nlist;
+        if (nprobe < 1) nprobe = 1;
+        std::vector<std::pair<double, int> > order(nlist);
+        for (int c = 0; c < nlist; ++c) {
+            double d = centroidNormSq[c] - 2.0 * LAKernels::dot(centroids.raw() + (size_t)c * dim, probe.data(), dim);
+            order[c] = std::make_pair(d, c);
+        }
+        std::partial_sort(order.begin(), order.begin() + nprobe, order.end());
+
+        LATopK best(k);
+        for (int p = 0; p < nprobe; ++p) {
+            int c = order[p].second;
+            const double* rows = lists[c].data();
+            for (size_t r = 0; r < ids[c].size(); ++r) {
+                double dot = LAKernels::dot(rows + r * dim, q.data(), dim);
+                best.offer(ids[c][r], knn_distance(metric, dot, normSq[c][r], qn));
+            }
+        }
+        return best.sorted();
+    }
+};
+
+// ------------------------------------------------------
+// Núcleos para matrices (GEMV: y = A x, GEMM: C += A B)
+// Un ciclo de dot_product por fila vuelve a leer todo x para cada fila.
+// Aquí se trabaja por "baldosas" (tiles) de 4 filas: cada trozo de x (o
+// de B) que se carga en un registro se usa 4 veces, y los acumuladores
+// viven en registros todo el ciclo. Con AVX2+FMA se usan intrínsecos; si
+// no (o en modo determinista, ver LAKernels) se usa la versión escalar.
+//
+// GEMM trabaja sobre paneles "empacados": antes de multiplicar, el bloque
+// de B se copia en tiras de 8 columnas y cada tira de 4 filas de A se copia
+// paso por paso. Así el núcleo lee ambos de forma contigua (sin saltar
+// 'n' doubles por fila de B) y cada tira ocupa pocas líneas de caché.
+// ------------------------------------------------------
+struct LAMatrixKernels {
+    // y[0..4) += A[0..4) · x, con A de 4 filas separadas por 'lda'
+    typedef void (*Gemv4Kernel)(const double*, int, const double*, int, double*);
+    // C[4 x 8] += Ap · Bp, con Ap[p * 4 + r] = A(r, p) y Bp[p * 8 + c] = B(p, c)
+    typedef void (*Gemm4x8Kernel)(const double*, const double*, double*, int, int);
+
+    static void gemv4Scalar(const double* A, int lda, const double* x, int n, double* y) {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (int j = 0; j < n; ++j) {
+            double xj = x[j];
+            s0 += A[j] * xj;
+            s1 += A[lda + j] * xj;
+            s2 += A[2 * (size_t)lda + j] * xj;
+            s3 += A[3 * (size_t)lda + j] * xj;
+        }
+        y[0] += s0;
+        y[1] += s1;
+        y[2] += s2;
+        y[3] += s3;
+    }
+
+    // Copia el bloque kc x nc de B (filas separadas por 'ldb') en tiras de
+    // 8 columnas: la tira s empieza en Bp + s * kc * 8 y su fila p ocupa
+    // [p * 8, p * 8 + 8). Las columnas que faltan en la última tira son ceros.
+    static void packB(const double* B, int ldb, int kc, int nc, double* Bp) {
+        for (int s = 0; s * 8 < nc; ++s) {
+            int nr = nc - s * 8 < 8 ? nc - s * 8 : 8;
+            double* dst = Bp + (size_t)s * kc * 8;
+            for (int p = 0; p < kc; ++p) {
+                const double* src = B + (size_t)p * ldb + s * 8;
+                int c = 0;
+                for (; c < nr; ++c) dst[p * 8 + c] = src[c];
+                for (; c < 8; ++c) dst[p * 8 + c] = 0.0;
+            }
+        }
+    }
+
+    // Copia mr <= 4 filas x kc de A (filas separadas por 'lda'): Ap[p * 4 + r].
+    // Las filas que faltan son ceros.
+    static void packA(const double* A, int lda, int mr, int kc, double* Ap) {
+        for (int p = 0; p < kc; ++p) {
+            for (int r = 0; r < 4; ++r) {
+                Ap[p * 4 + r] = r < mr ? A[(size_t)r * lda + p] : 0.0;
+            }
+        }
+    }
+
+    // Baldosa general de hasta 4 x 8 (también cubre los bordes de la matriz)
+    static void gemmEdge(const double* Ap, const double* Bp, double* C, int ldc, int mr, int nr, int kc) {
+        double acc[4][8];
+        for (int r = 0; r < mr; ++r) {
+            for (int c = 0; c < nr; ++c) acc[r][c] = C[(size_t)r * ldc + c];
+        }
+        for (int p = 0; p < kc; ++p) {
+            const double* b = Bp + (size_t)p * 8;
+            for (int r = 0; r < mr; ++r) {
+                double a = Ap[(size_t)p * 4 + r];
+                for (int c = 0; c < nr; ++c) acc[r][c] += a * b[c];
+            }
+        }
+        for (int r = 0; r < mr; ++r) {
+            for (int c = 0; c < nr; ++c) C[(size_t)r * ldc + c] = acc[r][c];
+        }
+    }
+
+    static void gemm4x8Scalar(const double* Ap, const double* Bp, double* C, int ldc, int kc) {
+        gemmEdge(Ap, Bp, C, ldc, 4, 8, kc);
+    }
+
+#ifdef LA_X86_SIMD
+    __attribute__((target("avx2,fma")))
+    static double hsum(__m256d v) {
+        double lanes[4];
+        _mm256_storeu_pd(lanes, v);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    // Cada carga de x se usa para las 4 filas
+    __attribute__((target("avx2,fma")))
+    static void gemv4AVX2(const double* A, int lda, const double* x, int n, double* y) {
+        const double* a1 = A + lda;
+        const double* a2 = A + 2 * (size_t)lda;
+        const double* a3 = A + 3 * (size_t)lda;
+        __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+        __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+        int j = 0;
+        for (; j + 4 <= n; j += 4) {
+            __m256d xv = _mm256_loadu_pd(x + j);
+            s0 = _mm256_fmadd_pd(_mm256_loadu_pd(A + j), xv, s0);
+            s1 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + j), xv, s1);
+            s2 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + j), xv, s2);
+            s3 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + j), xv, s3);
+        }
+        double r0 = hsum(s0), r1 = hsum(s1), r2 = hsum(s2), r3 = hsum(s3);
+        for (; j < n; ++j) {
+            r0 += A[j] * x[j];
+            r1 += a1[j] * x[j];
+            r2 += a2[j] * x[j];
+            r3 += a3[j] * x[j];
+        }
+        y[0] += r0;
+        y[1] += r1;
+        y[2] += r2;
+        y[3] += r3;
+    }
+
+    // 8 acumuladores de 4 doubles (la baldosa 4 x 8 de C) en registros
+    __attribute__((target("avx2,fma")))
+    static void gemm4x8AVX2(const double* Ap, const double* Bp, double* C, int ldc, int kc) {
+        double* c1 = C + ldc;
+        double* c2 = C + 2 * (size_t)ldc;
+        double* c3 = C + 3 * (size_t)ldc;
+        __m256d c00 = _mm256_loadu_pd(C), c01 = _mm256_loadu_pd(C + 4);
+        __m256d c10 = _mm256_loadu_pd(c1), c11 = _mm256_loadu_pd(c1 + 4);
+        __m256d c20 = _mm256_loadu_pd(c2), c21 = _mm256_loadu_pd(c2 + 4);
+        __m256d c30 = _mm256_loadu_pd(c3), c31 = _mm256_loadu_pd(c3 + 4);
+        for (int p = 0; p < kc; ++p) {
+            const double* b = Bp + (size_t)p * 8;
+            const double* a4 = Ap + (size_t)p * 4;
+            __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+            __m256d a = _mm256_broadcast_sd(a4);
+            c00 = _mm256_fmadd_pd(a, b0, c00);
+            c01 = _mm256_fmadd_pd(a, b1, c01);
+            a = _mm256_broadcast_sd(a4 + 1);
+            c10 = _mm256_fmadd_pd(a, b0, c10);
+            c11 = _mm256_fmadd_pd(a, b1, c11);
+            a = _mm256_broadcast_sd(a4 + 2);
+            c20 = _mm256_fmadd_pd(a, b0, c20);
+            c21 = _mm256_fmadd_pd(a, b1, c21);
+            a = _mm256_broadcast_sd(a4 + 3);
+            c30 = _mm256_fmadd_pd(a, b0, c30);
+            c31 = _mm256_fmadd_pd(a, b1, c31);
+        }
+        _mm256_storeu_pd(C, c00); _mm256_storeu_pd(C + 4, c01);
+        _mm256_storeu_pd(c1, c10); _mm256_storeu_pd(c1 + 4, c11);
+        _mm256_storeu_pd(c2, c20); _mm256_storeu_pd(c2 + 4, c21);
+        _mm256_storeu_pd(c3, c30); _mm256_storeu_pd(c3 + 4, c31);
+    }
+#endif
+
+    static bool hasAVX2() {
+#ifdef LA_X86_SIMD
+        static bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"));
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static Gemv4Kernel gemv4() {
+#ifdef LA_X86_SIMD
+        if (!LAKernels::deterministic() && hasAVX2()) return gemv4AVX2;
+#endif
+        return gemv4Scalar;
+    }
+
+    static Gemm4x8Kernel gemm4x8() {
+#ifdef LA_X86_SIMD
+        if (!LAKernels::deterministic() && hasAVX2()) return gemm4x8AVX2;
+#endif
+        return gemm4x8Scalar;
+    }
+};
+
+// ------------------------------------------------------
+// Clase: LAMatrix
+// Matriz densa guardada por filas en un solo arreglo.
+// - A * x (GEMV) y A * B (GEMM) usan los núcleos de LAMatrixKernels,
+//   recorren la memoria por bloques que caben en caché y reparten las
+//   baldosas de filas entre núcleos (LAThreads).
+// - row(i) y column(j) son LAVectorView sobre la propia matriz, así que
+//   funcionan con todas las operaciones de vectores.
+// ------------------------------------------------------
+class LAMatrix {
+private:
+    int nrows, ncols;
+    std::vector<double> values;
+
+    // Tamaños de bloque (GEMM): el panel empacado de B, KC x NC doubles
+    // (256 x 96 = 192 KB), cabe en una L2 de 256 KB o más y se reutiliza
+    // para todas las filas de A. En la L1 quedan la tira de A (4 x KC = 8 KB)
+    // y una tira de 8 columnas de B (KC x 8 = 16 KB). NC es múltiplo de 8.
+    static const int KC = 256;
+    static const int NC = 96;
+    // GEMV: trozo de x que se mantiene en L1 mientras se recorren las filas
+    static const int XC = 2048;
+
+    // Cuántas baldosas de 4 filas por hilo compensan crear el hilo
+    static int tileGrain(long long flopsPerTile) {
+        const long long minWork = 1LL << 22;
+        long long grain = flopsPerTile > 0 ? minWork / flopsPerTile : 1;
+        if (grain < 1) grain = 1;
+        if (grain > (1 << 20)) grain = 1 << 20;
+        return (int)grain;
+    }
+
+public:
+    LAMatrix(int rows, int cols, double init_value = 0.0) : nrows(rows), ncols(cols) {
+        if (rows <= 0 || cols <= 0) throw std::invalid_argument("Las dimensiones deben ser positivas.");
+        values.assign((size_t)rows * cols, init_value);
+    }
+
+    // Ejemplo: LAMatrix A = {{1, 2}, {3, 4}};
+    LAMatrix(std::initializer_list<std::initializer_list<double> > rows)
+        : nrows((int)rows.size()), ncols(rows.size() > 0 ? (int)rows.begin()->size() : 0) {
+        if (nrows == 0 || ncols == 0) throw std::invalid_argument("Las dimensiones deben ser positivas.");
+        values.reserve((size_t)nrows * ncols);
+        for (const std::initializer_list<double>& r : rows) {
+            if ((int)r.size() != ncols) throw std::invalid_argument("Todas las filas deben tener el mismo largo.");
+            values.insert(values.end(), r.begin(), r.end());
+        }
+    }
+
+    int rows() const { return nrows; }
+    int cols() const { return ncols; }
+    double operator()(int i, int j) const { return values[(size_t)i * ncols + j]; }
+    double& operator()(int i, int j) { return values[(size_t)i * ncols + j]; }
+    const double* raw() const { return values.data(); }
+    double* raw() { return values.data(); }
+
+    LAVectorView row(int i) {
+        if (i < 0 || i >= nrows) throw std::out_of_range("Fila fuera de la matriz.");
+        return LAVectorView(values.data() + (size_t)i * ncols, ncols, 1);
+    }
+
+    LAVectorView column(int j) {
+        if (j < 0 || j >= ncols) throw std::out_of_range("Columna fuera de la matriz.");
+        return LAVectorView(values.data() + j, nrows, ncols);
+    }
+
+    LAMatrix transpose() const {
+        LAMatrix t(ncols, nrows);
+        for (int i = 0; i < nrows; ++i) {
+            for (int j = 0; j < ncols; ++j) t(j, i) = (*this)(i, j);
+        }
+        return t;
+    }
+
+    // -------- GEMV: y = A x (x e y contiguos) --------
+    void multiply_into(const double* x, double* y) const {
+        LAMatrixKernels::Gemv4Kernel kernel = LAMatrixKernels::gemv4();
+        const double* A = values.data();
+        int m = nrows, n = ncols;
+        int tiles = (m + 3) / 4;
+        LAThreads::run(tiles, tileGrain(8LL * n), [=](int begin, int end) {
+            int r0 = begin * 4, r1 = end * 4 < m ? end * 4 : m;
+            for (int i = r0; i < r1; ++i) y[i] = 0.0;
+            // Por columnas en trozos de XC: el trozo de x queda en L1
+            for (int jc = 0; jc < n; jc += XC) {
+                int width = n - jc < XC ? n - jc : XC;
+                int i = r0;
+                for (; i + 4 <= r1; i += 4) {
+                    kernel(A + (size_t)i * n + jc, n, x + jc, width, y + i);
+                }
+                for (; i < r1; ++i) {
+                    y[i] += LAKernels::dot(A + (size_t)i * n + jc, x + jc, width);
+                }
+            }
+        });
+    }
+
+    template <class E>
+    LAVector operator*(const LAExpr<E>& expr) const {
+        const E& e = expr.self();
+        if (e.size() != ncols) throw std::invalid_argument("Dimensiones incompatibles para matriz por vector.");
+        std::vector<double> x(ncols);
+        for (int j = 0; j < ncols; ++j) x[j] = e[j];
+        LAVector y(nrows);
+        multiply_into(x.data(), &y[0]);
+        return y;
+    }
+
+    // -------- GEMM: C = A B --------
+    // Por cada bloque NC (columnas de C) x KC (producto interno) se empaca
+    // el panel de B una vez; luego cada hilo se queda con un rango de
+    // baldosas de 4 filas (así nunca escriben la misma fila), empaca su
+    // tira de A y la multiplica por todas las tiras del panel.
+    LAMatrix operator*(const LAMatrix& B) const {
+        if (ncols != B.nrows) throw std::invalid_argument("Dimensiones incompatibles para producto de matrices.");
+        LAMatrix C(nrows, B.ncols, 0.0);
+        LAMatrixKernels::Gemm4x8Kernel kernel = LAMatrixKernels::gemm4x8();
+        const double* a = values.data();
+        const double* b = B.values.data();
+        double* c = C.values.data();
+        int m = nrows, k = ncols, n = B.ncols;
+        int tiles = (m + 3) / 4;
+        std::vector<double> panel((size_t)KC * NC);
+        for (int jc = 0; jc < n; jc += NC) {
+            int nc = n - jc < NC ? n - jc : NC;
+            for (int pc = 0; pc < k; pc += KC) {
+                int kc = k - pc < KC ? k - pc : KC;
+                LAMatrixKernels::packB(b + (size_t)pc * n + jc, n, kc, nc, panel.data());
+                const double* bp = panel.data();
+                LAThreads::run(tiles, tileGrain(8LL * nc * kc), [=](int begin, int end) {
+                    double ap[4 * KC];
+                    for (int t = begin; t < end; ++t) {
+                        int i = t * 4;
+                        int mr = m - i < 4 ? m - i : 4;
+                        LAMatrixKernels::packA(a + (size_t)i * k + pc, k, mr, kc, ap);
+                        for (int j = 0; j < nc; j += 8) {
+                            int nr = nc - j < 8 ? nc - j : 8;
+                            const double* bs = bp + (size_t)j * kc; // Tira j / 8
+                            double* cp = c + (size_t)i * n + jc + j;
+                            if (mr == 4 && nr == 8) {
+                                kernel(ap, bs, cp, n, kc);
+                            } else {
+                                LAMatrixKernels::gemmEdge(ap, bs, cp, n, mr, nr, kc);
+                            }
+                        }
+                    }
+                });
+            }
+        }
+        return C;
+    }
+
+    void print() const {
+        for (int i = 0; i < nrows; ++i) {
+            std::cout << (i == 0 ? "[" : " ") << "(";
+            for (int j = 0; j < ncols; ++j) {
+                std::cout << (*this)(i, j);
+                if (j < ncols - 1) std::cout << ", ";
+            }
+            std::cout << ")" << (i == nrows - 1 ? "]" : "") << std::endl;
+        }
+    }
+};
+
+// ------------------------------------------------------
+// Clase: LASparseVector
+// Vector con casi todos sus componentes en cero: solo se guardan los
+// no nulos, como dos arreglos paralelos ordenados por índice
+// (indices[k], values[k]). Memoria y tiempo dependen de la cantidad de
+// no nulos (nnz), no de la dimensión.
+// - Producto punto con un vector denso: solo visita los nnz.
+// - Entre dos dispersos: se recorren ambos índices a la vez (como el
+//   "merge" de merge sort); si uno es mucho más corto se busca por
+//   bisección en el otro.
+// - Suma y resta: también por merge, el resultado sigue ordenado.
+// ------------------------------------------------------
+class LASparseVector {
+private:
+    int dim;
+    std::vector<int> indices;  // Estrictamente crecientes
+    std::vector<double> values;
+
+    void checkDim(int n) const {
+        if (n != dim) throw std::invalid_argument("Dimensiones incompatibles con el vector disperso.");
+    }
+
+    // a + sign * b, por merge de los dos arreglos de índices
+    static LASparseVector merge(const LASparseVector& a, const LASparseVector& b, double sign) {
+        a.checkDim(b.dim);
+        LASparseVector out(a.dim);
+        out.indices.reserve(a.indices.size() + b.indices.size());
+        out.values.reserve(a.indices.size() + b.indices.size());
+        size_t i = 0, j = 0;
+        while (i < a.indices.size() || j < b.indices.size()) {
+            double v;
+            int idx;
+            if (j == b.indices.size() || (i < a.indices.size() && a.indices[i] < b.indices[j])) {
+                idx = a.indices[i];
+                v = a.values[i++];
+            } else if (i == a.indices.size() || b.indices[j] < a.indices[i]) {
+                idx = b.indices[j];
+                v = sign * b.values[j++];
+            } else {
+                idx = a.indices[i];
+                v = a.values[i++] + sign * b.values[j++];
+            }
+            if (v != 0.0) { // Las cancelaciones no se guardan
+                out.indices.push_back(idx);
+                out.values.push_back(v);
+            }
+        }
+        return out;
+    }
+
+public:
+    // Vector nulo de dimensión 'dimension'
+    explicit LASparseVector(int dimension) : dim(dimension) {
+        if (dim <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
+    }
+
+    // Desde pares (índice, valor) en cualquier orden; los repetidos se suman
+    LASparseVector(int dimension, const std::vector<int>& idx, const std::vector<double>& vals)
+        : dim(dimension) {
+        if (dim <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
+        if (idx.size() != vals.size()) throw std::invalid_argument("Índices y valores de distinto largo.");
+        std::vector<std::pair<int, double> > pairs(idx.size());
+        for (size_t k = 0; k < idx.size(); ++k) {
+            if (idx[k] < 0 || idx[k] >= dim) throw std::out_of_range("Índice fuera del vector disperso.");
+            pairs[k] = std::make_pair(idx[k], vals[k]);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            if (!indices.empty() && indices.back() == pairs[k].first) {
+                values.back() += pairs[k].second;
+            } else {
+                indices.push_back(pairs[k].first);
+                values.push_back(pairs[k].second);
+            }
+        }
+        // Quitar los que quedaron en cero
+        size_t w = 0;
+        for (size_t k = 0; k < indices.size(); ++k) {
+            if (values[k] != 0.0) {
+                indices[w] = indices[k];
+                values[w++] = values[k];
+            }
+        }
+        indices.resize(w);
+        values.resize(w);
+    }
+
+    // Desde un vector denso (LAVector, vista, expresión): guarda solo los no nulos
+    template <class E>
+    explicit LASparseVector(const LAExpr<E>& expr) : dim(expr.self().size()) {
+        if (dim <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
+        const E& e = expr.self();
+        for (int i = 0; i < dim; ++i) {
+            double v = e[i];
+            if (v != 0.0) {
+                indices.push_back(i);
+                values.push_back(v);
+            }
+        }
+    }
+
+    int size() const { return dim; }
+    int nnz() const { return (int)indices.size(); }
+    double fill_ratio() const { return (double)indices.size() / dim; }
+    const std::vector<int>& nonzero_indices() const { return indices; }
+    const std::vector<double>& nonzero_values() const { return values; }
+
+    // Componente i (búsqueda binaria): O(log nnz)
+    double get(int i) const {
+        std::vector<int>::const_iterator it = std::lower_bound(indices.begin(), indices.end(), i);
+        if (it == indices.end() || *it != i) return 0.0;
+        return values[it - indices.begin()];
+    }
+
+    // Cambia el componente i (insertar en medio es O(nnz); para armar
+    // vectores grandes conviene el constructor con pares)
+    void set(int i, double v) {
+        if (i < 0 || i >= dim) throw std::out_of_range("Índice fuera del vector disperso.");
+        std::vector<int>::iterator it = std::lower_bound(indices.begin(), indices.end(), i);
+        size_t pos = it - indices.begin();
+        if (it != indices.end() && *it == i) {
+            if (v != 0.0) {
+                values[pos] = v;
+            } else {
+                indices.erase(it);
+                values.erase(values.begin() + pos);
+            }
+        } else if (v != 0.0) {
+            indices.insert(it, i);
+            values.insert(values.begin() + pos, v);
+        }
+    }
+
+    // -------- Producto punto disperso · denso --------
+    template <class E>
+    double dot_product(const LAExpr<E>& dense) const {
+        const E& x = dense.self();
+        checkDim(x.size());
+        double s0 = 0.0, s1 = 0.0;
+        size_t k = 0, n = indices.size();
+        for (; k + 2 <= n; k += 2) {
+            s0 += values[k] * x[indices[k]];
+            s1 += values[k + 1] * x[indices[k + 1]];
+        }
+        if (k < n) s0 += values[k] * x[indices[k]];
+        return s0 + s1;
+    }
+
+    // -------- Producto punto disperso · disperso --------
+    double dot_product(const LASparseVector& other) const {
+        checkDim(other.dim);
+        const LASparseVector* small = this;
+        const LASparseVector* large = &other;
+        if (small->indices.size() > large->indices.size()) std::swap(small, large);
+        size_t ns = small->indices.size(), nl = large->indices.size();
+        double sum = 0.0;
+        if (ns * 16 < nl) {
+            // Muy desbalanceados: bisección en el largo desde la última posición
+            std::vector<int>::const_iterator from = large->indices.begin();
+            for (size_t i = 0; i < ns; ++i) {
+                from = std::lower_bound(from, large->indices.end(), small->indices[i]);
+                if (from == large->indices.end()) break;
+                if (*from == small->indices[i]) {
+                    sum += small->values[i] * large->values[from - large->indices.begin()];
+                }
+            }
+            return sum;
+        }
+        size_t i = 0, j = 0;
+        while (i < ns && j < nl) {
+            int a = small->indices[i], b = large->indices[j];
+            if (a < b) {
+                ++i;
+            } else if (b < a) {
+                ++j;
+            } else {
+                sum += small->values[i++] * large->values[j++];
+            }
+        }
+        return sum;
+    }
+
+    double magnitude() const {
+        return std::sqrt(LAKernels::dot(values.data(), values.data(), (int)values.size()));
+    }
+
+    LASparseVector operator+(const LASparseVector& rhs) const { return merge(*this, rhs, 1.0); }
+    LASparseVector operator-(const LASparseVector& rhs) const { return merge(*this, rhs, -1.0); }
+
+    LASparseVector operator*(double scalar) const {
+        if (scalar == 0.0) return LASparseVector(dim);
+        LASparseVector out(*this);
+        for (size_t k = 0; k < out.values.size(); ++k) out.values[k] *= scalar;
+        return out;
+    }
+
+    // dense += a * this (solo toca las posiciones no nulas)
+    void add_to(LAVector& dense, double a = 1.0) const {
+        checkDim(dense.size());
+        for (size_t k = 0; k < indices.size(); ++k) {
+            dense[indices[k]] = std::fma(a, values[k], dense[indices[k]]);
+        }
+    }
+
+    LAVector to_dense() const {
+        LAVector out(dim, 0.0);
+        add_to(out);
+        return out;
+    }
+
+    void print() const {
+        std::cout << "{dim " << dim << ":";
+        for (size_t k = 0; k < indices.size(); ++k) {
+            std::cout << " [" << indices[k] << "]=" << values[k];
+        }
+        std::cout << "}";
+    }
+};
+
+template <class E>
+double dot_product(const LASparseVector& lhs, const LAExpr<E>& rhs) {
+    return lhs.dot_product(rhs);
+}
+
+template <class E>
+double dot_product(const LAExpr<E>& lhs, const LASparseVector& rhs) {
+    return rhs.dot_product(lhs);
+}
+
+inline double dot_product(const LASparseVector& lhs, const LASparseVector& rhs) {
+    return lhs.dot_product(rhs);
+}
+
+// ------------------------------------------------------
+// Clase: LAAdaptiveVector
+// Elige sola entre guardar el vector denso (LAVector) o disperso
+// (LASparseVector) según su proporción de no nulos, y vuelve a elegir
+// después de cada suma. Un disperso gasta 12 bytes por no nulo (índice
+// + valor) contra 8 por componente del denso, y su producto punto salta
+// por la memoria; por eso solo conviene con pocos no nulos.
+// ------------------------------------------------------
+class LAAdaptiveVector {
+private:
+    // Umbrales con histéresis: un denso pasa a disperso con a lo más 20%
+    // de no nulos y un disperso pasa a denso con más de 30%. Entre ambos
+    // se queda como está, para no convertir en cada suma cerca del borde.
+    static constexpr double TO_SPARSE_FILL = 0.2;
+    static constexpr double TO_DENSE_FILL = 0.3;
+
+    bool isSparse;
+    LASparseVector sparse; // Válido si isSparse
+    LAVector dense;        // Válido si !isSparse (si no, queda de 1 componente, sin 'new')
+
+    // Proporción de no nulos sin armar nada: una pasada de lectura
+    template <class E>
+    static double fillOf(const LAExpr<E>& expr) {
+        const E& e = expr.self();
+        int n = e.size();
+        if (n <= 0) throw std::invalid_argument("La dimensión debe ser positiva.");
+        int count = 0;
+        for (int i = 0; i < n; ++i) {
+            if (e[i] != 0.0) ++count;
+        }
+        return (double)count / n;
+    }
+
+    void useSparse(LASparseVector&& s) {
+        sparse = std::move(s);
+        dense = LAVector(1);
+        isSparse = true;
+    }
+
+    void useDense(LAVector&& d) {
+        dense = std::move(d);
+        sparse = LASparseVector(1);
+        isSparse = false;
+    }
+
+    // Cambia de representación si la proporción de no nulos lo pide.
+    // En denso primero se cuentan los no nulos; el disperso solo se arma
+    // cuando de verdad se cambia.
+    void rebalance() {
+        if (isSparse) {
+            if (sparse.fill_ratio() > TO_DENSE_FILL) useDense(sparse.to_dense());
+        } else if (fillOf(dense) <= TO_SPARSE_FILL) {
+            useSparse(LASparseVector(dense));
+        }
+    }
+
+public:
+    // Un vector nuevo se trata como si viniera disperso: solo es denso
+    // si pasa TO_DENSE_FILL
+    template <class E>
+    LAAdaptiveVector(const LAExpr<E>& expr) : isSparse(true), sparse(1), dense(1) {
+        if (fillOf(expr) > TO_DENSE_FILL) {
+            useDense(LAVector(expr));
+        } else {
+            sparse = LASparseVector(expr);
+        }
+    }
+
+    LAAdaptiveVector(const LASparseVector& s) : isSparse(true), sparse(s), dense(1) {
+        rebalance();
+    }
+
+    bool is_sparse() const { return isSparse; }
+    int size() const { return isSparse ? sparse.size() : dense.size(); }
+
+    double dot_product(const LAAdaptiveVector& other) const {
+        if (isSparse) {
+            return other.isSparse ? sparse.dot_product(other.sparse) : sparse.dot_product(other.dense);
+        }
+        return other.isSparse ? other.sparse.dot_product(dense) : dense.dot_product(other.dense);
+    }
+
+    double magnitude() const {
+        return isSparse ? sparse.magnitude() : dense.magnitude();
+    }
+
+    LAAdaptiveVector& operator+=(const LAAdaptiveVector& other) {
+        if (size() != other.size()) throw std::invalid_argument("Dimensiones incompatibles para la suma.");
+        if (isSparse && other.isSparse) {
+            sparse = sparse + other.sparse;
+        } else if (isSparse) {
+            LAVector sum = other.dense;
+            sparse.add_to(sum);
+            useDense(std::move(sum));
+        } else if (other.isSparse) {
+            other.sparse.add_to(dense);
+        } else {
+            dense += other.dense;
+        }
+        rebalance();
+        return *this;
+    }
+
+    LAVector to_dense() const {
+        return isSparse ? sparse.to_dense() : dense;
+    }
+};
+
+// ------------------------------------------------------
+// Programa de prueba
+// ------------------------------------------------------
+int main() {
+    // Creamos dos vectores en R^3 (3D)
+    LAVector v1 = {1.0, 2.0, 3.0};
+    LAVector v2 = {4.0, 5.0, 6.0};
+
+    // Suma
+    LAVector suma = v1 + v2;
+    std::cout << "Suma: "; suma.print(); std::cout << std::endl;
+
+    // Resta
+    LAVector resta = v1 - v2;
+    std::cout << "Resta: "; resta.print(); std::cout << std::endl;
+
+    // Multiplicación por escalar
+    LAVector escalar = v1 * 2.0;
+    std::cout << "Escalar (v1 * 2): "; escalar.print(); std::cout << std::endl;
+
+    // Producto punto
+    double dot = v1.dot_product(v2);
+    std::cout << "Producto punto (v1 · v2): " << dot << std::endl;
+
+    // Magnitud
+    std::cout << "Magnitud de v1: " << v1.magnitude() << std::endl;
+
+    // Normalización
+    LAVector v1_norm = v1.normalize();
+    std::cout << "Normalización de v1: "; v1_norm.print(); std::cout << std::endl;
+
+    // Cadena de operaciones: se evalúa en un solo ciclo, con un solo 'new'
+    LAVector cadena = (v1 + v2 - v1) * 2.0;
+    std::cout << "Cadena ((v1 + v2 - v1) * 2): "; cadena.print(); std::cout << std::endl;
+
+    // Un nodo guardado con 'auto' (los temporales internos van por valor)
+    // y los métodos de LAVector directamente sobre una expresión
+    auto doble = (v1 + v2) * 2.0;
+    std::cout << "auto doble = (v1 + v2) * 2: "; doble.print();
+    std::cout << ", magnitud " << doble.magnitude() << std::endl;
+    std::cout << "(v1 + v2).normalize(): "; (v1 + v2).normalize().print(); std::cout << std::endl;
+
+    // Producto punto y magnitud directamente sobre expresiones (sin temporales)
+    std::cout << "(v1 + v2) · (v2 - v1): " << dot_product(v1 + v2, v2 - v1) << std::endl;
+    std::cout << "Magnitud de (v1 * 2 - v2): " << magnitude(v1 * 2.0 - v2) << std::endl;
+
+    // Núcleo SIMD elegido para esta CPU, y el modo determinista
+    LAVector largo(1000001, 0.5);
+    std::cout << "Núcleo de producto punto: " << LAKernels::name() << std::endl;
+    std::cout << "largo · largo = " << largo.dot_product(largo) << std::endl;
+    LAKernels::set_deterministic(true);
+    std::cout << "Núcleo: " << LAKernels::name() << ", largo · largo = "
+              << largo.dot_product(largo) << std::endl;
+    LAKernels::set_deterministic(false);
+
+    // Operaciones en el lugar: el acumulador no pide memoria en el ciclo
+    LAVector acc(3, 0.0);
+    for (int k = 1; k <= 3; ++k) {
+        acc.axpy(k, v1);   // acc += k * v1
+    }
+    acc -= v2;
+    acc *= 0.5;
+    std::cout << "acc = (6 * v1 - v2) / 2: "; acc.print(); std::cout << std::endl;
+    acc.axpby(1.0, v2, 2.0); // acc = v2 + 2 * acc
+    acc.normalize_inplace();
+    std::cout << "normalize_inplace(v2 + 2 * acc): "; acc.print(); std::cout << std::endl;
+
+    // Vistas: operar sobre memoria ajena sin copiarla
+    // Matriz 3x3 guardada por filas en un std::vector
+    std::vector<double> buffer = {1.0, 2.0, 3.0,
+                                  4.0, 5.0, 6.0,
+                                  7.0, 8.0, 9.0};
+    LAVectorView fila1(buffer, 3, 3);      // {4, 5, 6}
+    LAVectorView columna0(buffer, 0, 3, 3); // {1, 4, 7} (salto 3)
+    std::cout << "fila1 · columna0: " << dot_product(fila1, columna0) << std::endl;
+    LAVector mezcla = fila1 + v1;           // Vista y LAVector en la misma expresión
+    std::cout << "fila1 + v1: "; mezcla.print(); std::cout << std::endl;
+    columna0 *= 10.0;                       // Escribe directo en 'buffer'
+    std::cout << "buffer[6] tras columna0 *= 10: " << buffer[6] << std::endl;
+    LAVectorView(v2).slice(0, 2) = LAVectorView(buffer, 0, 2); // v2[0..1] = buffer[0..1]
+    std::cout << "v2 tras copiar dos componentes de buffer: "; v2.print(); std::cout << std::endl;
+
+    // Lote de vectores en un solo arreglo (las dos formas de ordenarlos)
+    LAVectorBatch filas(3, 3, LA_ROW_MAJOR);
+    LAVectorBatch soa(3, 3, LA_SOA);
+    for (int i = 0; i < 3; ++i) {
+        LAVector vi = v1 * (double)(i + 1);   // (1,2,3), (2,4,6), (3,6,9)
+        filas.set(i, vi);
+        soa.set(i, vi);
+    }
+    std::vector<double> puntos = soa.dot(v1);
+    std::cout << "Lote · v1: " << puntos[0] << " " << puntos[1] << " " << puntos[2] << std::endl;
+    filas += soa;                             // Suma por pares (distinto orden)
+    filas.normalize_all();
+    std::cout << "Vector 2 del lote normalizado: "; filas.row(2).print(); std::cout << std::endl;
+
+    // k-NN: fuerza bruta exacta vs. IVF aproximado (recall@10 y consultas/s)
+    {
+        srand(42); // Datos reproducibles
+        const int n = 20000, d = 32, grupos = 64, consultas = 200, k = 10;
+        LAVectorBatch corpus(n, d);
+        std::vector<double> centros((size_t)grupos * d);
+        for (size_t t = 0; t < centros.size(); ++t) centros[t] = rand() % 2001 / 100.0 - 10.0;
+        for (int i = 0; i < n; ++i) {
+            int g = rand() % grupos;
+            for (int j = 0; j < d; ++j) {
+                corpus.at(i, j) = centros[(size_t)g * d + j] + (rand() % 2001 / 1000.0 - 1.0);
+            }
+        }
+        LAVectorBatch preguntas(consultas, d);
+        for (int i = 0; i < consultas; ++i) {
+            int g = rand() % grupos;
+            for (int j = 0; j < d; ++j) {
+                preguntas.at(i, j) = centros[(size_t)g * d + j] + (rand() % 2001 / 1000.0 - 1.0);
+            }
+        }
+
+        LAFlatIndex exacto(corpus, LA_L2);
+        LAIVFIndex ivf(corpus, 128, LA_L2);
+        std::vector<std::vector<LANeighbor> > verdad(consultas);
+
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < consultas; ++i) verdad[i] = exacto.search(preguntas.row(i), k);
+        double segFlat = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        t0 = std::chrono::steady_clock::now();
+        std::vector<std::vector<LANeighbor> > enLote = exacto.search_batch(preguntas, k);
+        double segLote = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        bool mismos = true;
+        for (int i = 0; i < consultas; ++i) {
+            for (int a = 0; a < k; ++a) mismos = mismos && enLote[i][a].index == verdad[i][a].index;
+        }
+
+        int nprobes[] = {1, 4, 16};
+        std::cout << "k-NN sobre " << n << " vectores de dimensión " << d << ":" << std::endl;
+        std::cout << std::fixed;
+        std::cout.precision(3);
+        std::cout << "  fuerza bruta: recall 1.000, " << (int)(consultas / segFlat) << " consultas/s" << std::endl;
+        std::cout << "  fuerza bruta (search_batch): " << (int)(consultas / segLote) << " consultas/s"
+                  << (mismos ? " (mismos vecinos)" : " (DISTINTOS)") << std::endl;
+        for (int p = 0; p < 3; ++p) {
+            int aciertos = 0;
+            t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < consultas; ++i) {
+                std::vector<LANeighbor> res = ivf.search(preguntas.row(i), k, nprobes[p]);
+                for (size_t a = 0; a < res.size(); ++a) {
+                    for (size_t b = 0; b < verdad[i].size(); ++b) {
+                        if (res[a].index == verdad[i][b].index) aciertos++;
+                    }
+                }
+            }
+            double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            std::cout << "  IVF nprobe=" << nprobes[p] << ": recall "
+                      << (double)aciertos / (consultas * k) << ", " << (int)(consultas / seg) << " consultas/s" << std::endl;
+        }
+
+        LAFlatIndex coseno(corpus, LA_COSINE);
+        std::vector<LANeighbor> cerca = coseno.search(corpus.row(7), 3);
+        std::cout << "  coseno: más cercano a corpus[7] es " << cerca[0].index
+                  << " (distancia " << cerca[0].distance << ")" << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout.precision(6);
+    }
+
+    // Matrices: A * x (GEMV) y A * B (GEMM) por baldosas
+    LAMatrix A = {{1.0, 2.0, 3.0},
+                  {4.0, 5.0, 6.0}};
+    LAVector Ax = A * v1;
+    std::cout << "A * v1: "; Ax.print(); std::cout << std::endl;
+    LAMatrix AAt = A * A.transpose();
+    std::cout << "A * A^T:" << std::endl;
+    AAt.print();
+    std::cout << "Columna 1 de A · v1[0..1]: " << dot_product(A.column(1), LAVectorView(v1).slice(0, 2)) << std::endl;
+    {
+        // GEMM 384 x 384: triple ciclo simple vs. versión por bloques
+        const int n = 384;
+        LAMatrix P(n, n), Q(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                P(i, j) = (i * 7 + j * 3) % 11 - 5;
+                Q(i, j) = (i * 5 + j * 2) % 13 - 6;
+            }
+        }
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        LAMatrix simple(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                double sum = 0.0;
+                for (int p = 0; p < n; ++p) sum += P(i, p) * Q(p, j);
+                simple(i, j) = sum;
+            }
+        }
+        double segSimple = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        t0 = std::chrono::steady_clock::now();
+        LAMatrix bloques = P * Q;
+        double segBloques = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        bool iguales = true;
+        for (int i = 0; i < n && iguales; ++i) {
+            for (int j = 0; j < n; ++j) iguales = iguales && simple(i, j) == bloques(i, j);
+        }
+        double flops = 2.0 * n * n * n;
+        std::cout << "GEMM " << n << "x" << n << ": simple " << flops / segSimple / 1e9
+                  << " GFLOP/s, por bloques " << flops / segBloques / 1e9 << " GFLOP/s"
+                  << (iguales ? " (mismo resultado)" : " (DISTINTO)") << std::endl;
+    }
+
+    // Vectores dispersos: solo se guardan (y recorren) los no nulos
+    LASparseVector d1(1000000, {10, 500000, 999999}, {1.0, 2.0, 3.0});
+    LASparseVector d2(1000000, {10, 999999, 42}, {4.0, 5.0, 6.0});
+    std::cout << "d1 · d2 (disperso · disperso): " << d1.dot_product(d2) << std::endl;
+    LAVector denso(1000000, 0.5);
+    std::cout << "d1 · denso (disperso · denso): " << dot_product(d1, denso) << std::endl;
+    LASparseVector dsum = d1 + d2;
+    std::cout << "d1 + d2: nnz = " << dsum.nnz() << ", magnitud = " << dsum.magnitude() << std::endl;
+    LAAdaptiveVector a1(LAVector({0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}));
+    LAAdaptiveVector a2(LAVector({1.0, 2.0, 0.0, 3.0, 0.0, 4.0, 0.0, 5.0}));
+    std::cout << "a1 disperso? " << (a1.is_sparse() ? "Si" : "No")
+              << ", a2 disperso? " << (a2.is_sparse() ? "Si" : "No")
+              << ", a1 · a2 = " << a1.dot_product(a2) << std::endl;
+    a1 += a2;
+    std::cout << "a1 += a2 -> disperso? " << (a1.is_sparse() ? "Si" : "No") << std::endl;
+
+    // Dimensión fija: sin memoria dinámica, y calculable al compilar
+    constexpr LAFixedVector<3> f1(1.0, 2.0, 3.0);
+    constexpr LAFixedVector<3> f2(4.0, 5.0, 6.0);
+    constexpr double fdot = (f1 + f2).dot_product(f1 * 2.0);
+    static_assert(fdot == 92.0, "Calculado al compilar");
+    std::cout << "LAFixedVector<3>: (f1 + f2) · (f1 * 2) = " << fdot << std::endl;
 
     return 0;
 }
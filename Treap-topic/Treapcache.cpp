@@ -0,0 +1,411 @@
+#include <iostream>
+#include <string>  // Para usar std::string
+#include <vector>  // Para listar las llaves en orden
+#include <cstdlib> // Para rand() y srand()
+#include <ctime>   // Para time()
+
+using namespace std;
+
+typedef int Key;
+typedef string Value;
+
+// Política de desalojo cuando el caché está lleno
+enum EvictionPolicy {
+    LRU, // Sale la entrada usada hace más tiempo
+    LFU  // Sale la entrada usada menos veces (empate: la más antigua)
+};
+
+/**
+ * @brief Nodo para el TreapCache.
+ * Además de lo de TreapMap, cada nodo está enhebrado en una lista
+ * doble de recencia ('newer'/'older'), sin memoria extra por fuera.
+ */
+struct Node {
+    Key key;
+    Value value;
+    int priority;
+    Node *left, *right;   // Hijos en el treap
+    Node *newer, *older;  // Vecinos en la lista de recencia
+
+    // Para LFU: uso (veces, último tick) y el mínimo de todo el subárbol
+    long long hits, lastUse;
+    long long minHits, minLastUse;
+
+    // Constructor: asigna llave, valor y prioridad aleatoria
+    Node(Key k, Value v, long long tick) {
+        key = k;
+        value = v;
+        priority = rand();
+        left = nullptr;
+        right = nullptr;
+        newer = nullptr;
+        older = nullptr;
+        hits = 1;
+        lastUse = tick;
+        minHits = hits;
+        minLastUse = lastUse;
+    }
+};
+
+/**
+ * @brief Caché con capacidad máxima sobre un treap propio.
+ * No reutiliza TreapMap (cada archivo es un programa aparte): copia su
+ * inserción y borrado, y les agrega la lista de recencia y el mínimo de
+ * uso por subárbol. Un arreglo en TreapMap hay que repetirlo aquí.
+ * - get() con acierto mueve la entrada al frente de la lista: O(1).
+ * - put() de una llave nueva con el caché lleno desaloja una entrada.
+ * - Sigue siendo un BST: se puede recorrer en orden (keys()),
+ *   cosa que un LRU basado en unordered_map no permite.
+ */
+class TreapCache {
+private:
+    Node* root;       // Raíz del treap
+    int nodeCount;    // Entradas actuales
+    int maxEntries;   // Capacidad
+    EvictionPolicy policy;
+
+    Node* newest;     // Frente de la lista (usada más recientemente)
+    Node* oldest;     // Final de la lista (víctima en LRU)
+    long long tick;   // Reloj lógico de usos
+
+    // --- Lista de recencia (intrusiva) ---
+
+    void unlink(Node* node) {
+        if (node->newer != nullptr) node->newer->older = node->older;
+        else newest = node->older;
+        if (node->older != nullptr) node->older->newer = node->newer;
+        else oldest = node->newer;
+        node->newer = nullptr;
+        node->older = nullptr;
+    }
+
+    void pushFront(Node* node) {
+        node->older = newest;
+        node->newer = nullptr;
+        if (newest != nullptr) newest->newer = node;
+        newest = node;
+        if (oldest == nullptr) oldest = node;
+    }
+
+    // --- Mínimo (hits, lastUse) del subárbol, para LFU ---
+
+    // true si el uso (h1, t1) es "menor" (menos frecuente o más antiguo)
+    static bool lessUse(long long h1, long long t1, long long h2, long long t2) {
+        return h1 < h2 || (h1 == h2 && t1 < t2);
+    }
+
+    static void update(Node* node) {
+        node->minHits = node->hits;
+        node->minLastUse = node->lastUse;
+        Node* kids[2] = {node->left, node->right};
+        for (int i = 0; i < 2; i++) {
+            Node* c = kids[i];
+            if (c != nullptr && lessUse(c->minHits, c->minLastUse, node->minHits, node->minLastUse)) {
+                node->minHits = c->minHits;
+                node->minLastUse = c->minLastUse;
+            }
+        }
+    }
+
+    // --- Funciones de Rotación ---
+    // Idénticas a las de TreapSet, pero mantienen el mínimo de uso.
+
+    Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Ayudante recursivo para insertar (llave, valor).
+     * 'touched' recibe el nodo nuevo, o el existente si solo se actualizó;
+     * 'created' dice cuál de los dos casos fue.
+     */
+    Node* insertRecursive(Node* node, Key key, const Value& value, Node*& touched, bool& created) {
+        if (node == nullptr) {
+            nodeCount++;
+            created = true;
+            touched = new Node(key, value, ++tick);
+            return touched;
+        }
+
+        if (key < node->key) {
+            node->left = insertRecursive(node->left, key, value, touched, created);
+            if (node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (key > node->key) {
+            node->right = insertRecursive(node->right, key, value, touched, created);
+            if (node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        } else {
+            node->value = value;
+            node->hits++;
+            node->lastUse = ++tick;
+            touched = node;
+        }
+        update(node);
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para eliminar (por llave).
+     * Lógica idéntica a TreapMap; además saca al nodo de la lista.
+     */
+    Node* removeRecursive(Node* node, Key key) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (key < node->key) {
+            node->left = removeRecursive(node->left, key);
+        } else if (key > node->key) {
+            node->right = removeRecursive(node->right, key);
+        } else {
+            if (node->left == nullptr || node->right == nullptr) {
+                Node* temp = node->left == nullptr ? node->right : node->left;
+                unlink(node);
+                delete node;
+                nodeCount--;
+                return temp;
+            }
+
+            // 2 hijos: rotar
+            if (node->left->priority > node->right->priority) {
+                node = rotateRight(node);
+                node->right = removeRecursive(node->right, key);
+            } else {
+                node = rotateLeft(node);
+                node->left = removeRecursive(node->left, key);
+            }
+        }
+        update(node);
+        return node;
+    }
+
+    /**
+     * @brief Búsqueda para LFU: cuenta el uso y recalcula los mínimos
+     * del camino al volver. Como en el modo auto-ajustable de TreapMap,
+     * sortea una prioridad nueva y se queda con la mayor, así las
+     * entradas frecuentes suben hacia la raíz.
+     */
+    Node* touchRecursive(Node* node, Key key, Node*& found) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (key < node->key) {
+            node->left = touchRecursive(node->left, key, found);
+            if (node->left != nullptr && node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (key > node->key) {
+            node->right = touchRecursive(node->right, key, found);
+            if (node->right != nullptr && node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        } else {
+            found = node;
+            node->hits++;
+            node->lastUse = ++tick;
+            int bump = rand();
+            if (bump > node->priority) {
+                node->priority = bump;
+            }
+        }
+        update(node);
+        return node;
+    }
+
+    Node* findNode(Node* node, Key key) {
+        while (node != nullptr && key != node->key) {
+            node = key < node->key ? node->left : node->right;
+        }
+        return node;
+    }
+
+    // Baja siguiendo el mínimo (hits, lastUse) hasta la entrada que lo tiene
+    Node* leastFrequent() {
+        Node* node = root;
+        while (node != nullptr) {
+            if (node->hits == node->minHits && node->lastUse == node->minLastUse) {
+                return node;
+            }
+            Node* l = node->left;
+            if (l != nullptr && l->minHits == node->minHits && l->minLastUse == node->minLastUse) {
+                node = l;
+            } else {
+                node = node->right;
+            }
+        }
+        return nullptr;
+    }
+
+    // Elige la víctima según la política (sin eliminarla)
+    Node* victim() {
+        return policy == LRU ? oldest : leastFrequent();
+    }
+
+    void collectKeys(Node* node, vector<Key>& out) {
+        if (node != nullptr) {
+            collectKeys(node->left, out);
+            out.push_back(node->key);
+            collectKeys(node->right, out);
+        }
+    }
+
+    // Libera toda la memoria
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor: caché vacío con capacidad 'capacity'
+    TreapCache(int capacity, EvictionPolicy evictionPolicy = LRU) {
+        root = nullptr;
+        nodeCount = 0;
+        maxEntries = capacity > 0 ? capacity : 1;
+        policy = evictionPolicy;
+        newest = nullptr;
+        oldest = nullptr;
+        tick = 0;
+    }
+
+    // Destructor
+    ~TreapCache() {
+        clear();
+    }
+
+    // Vacía el caché
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+        newest = nullptr;
+        oldest = nullptr;
+    }
+
+    int size() {
+        return nodeCount;
+    }
+
+    int capacity() {
+        return maxEntries;
+    }
+
+    /**
+     * @brief Inserta o actualiza (llave, valor) y la marca como usada.
+     * Si la llave es nueva y el caché estaba lleno, desaloja una.
+     * Se baja una sola vez: la víctima se elige antes de insertar (así la
+     * entrada nueva no compite) y solo sale si la llave resultó nueva.
+     */
+    void put(Key key, Value value) {
+        Node* evict = nodeCount >= maxEntries ? victim() : nullptr;
+        Node* touched = nullptr;
+        bool created = false;
+        root = insertRecursive(root, key, value, touched, created);
+        if (!created) {
+            unlink(touched); // Ya estaba en la lista
+        } else if (evict != nullptr) {
+            root = removeRecursive(root, evict->key);
+        }
+        pushFront(touched);
+    }
+
+    /**
+     * @brief Retorna el valor (y cuenta el acierto) o 'defaultValue'.
+     * En LRU el acierto solo mueve el nodo al frente de la lista: O(1)
+     * tras la búsqueda.
+     */
+    Value get(Key key, Value defaultValue) {
+        Node* found = nullptr;
+        if (policy == LFU) {
+            root = touchRecursive(root, key, found);
+        } else {
+            found = findNode(root, key);
+        }
+        if (found == nullptr) {
+            return defaultValue;
+        }
+        unlink(found);
+        pushFront(found);
+        return found->value;
+    }
+
+    // Consulta sin contar como uso
+    bool contains(Key key) {
+        return findNode(root, key) != nullptr;
+    }
+
+    void remove(Key key) {
+        root = removeRecursive(root, key);
+    }
+
+    // Todas las llaves en orden ascendente
+    vector<Key> keys() {
+        vector<Key> out;
+        collectKeys(root, out);
+        return out;
+    }
+};
+
+// Imprime las llaves del caché en orden
+void printKeys(TreapCache& cache) {
+    vector<Key> k = cache.keys();
+    for (size_t i = 0; i < k.size(); i++) {
+        cout << k[i] << " ";
+    }
+    cout << endl;
+}
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de TreapCache LRU (capacidad 3) ---" << endl;
+    TreapCache lru(3, LRU);
+    lru.put(10, "diez");
+    lru.put(20, "veinte");
+    lru.put(30, "treinta");
+    lru.get(10, "N/A");      // 10 pasa a ser la más reciente
+    lru.put(40, "cuarenta"); // Sale 20 (la menos reciente)
+    cout << "Tras put(10,20,30), get(10), put(40): ";
+    printKeys(lru);
+
+    cout << "--- Ejemplo de TreapCache LFU (capacidad 3) ---" << endl;
+    TreapCache lfu(3, LFU);
+    lfu.put(1, "uno");
+    lfu.put(2, "dos");
+    lfu.put(3, "tres");
+    lfu.get(1, "N/A");
+    lfu.get(1, "N/A");
+    lfu.get(3, "N/A");
+    lfu.put(4, "cuatro");    // Sale 2 (usada una sola vez)
+    cout << "Tras usar 1 (x3) y 3 (x2), put(4): ";
+    printKeys(lfu);
+    cout << "get(2, 'N/A'): " << lfu.get(2, "N/A") << endl;
+
+    return 0;
+}
@@ -0,0 +1,301 @@
+#include <iostream>
+#include <vector>  // Para devolver los intervalos encontrados
+#include <cstdlib> // Para rand() y srand()
+#include <ctime>   // Para time()
+
+using namespace std;
+
+/**
+ * @brief Intervalo cerrado [start, end] (ej. un rango de tiempo).
+ */
+struct Interval {
+    int start;
+    int end;
+};
+
+/**
+ * @brief Nodo para el IntervalTreap.
+ * La llave del BST es el intervalo (ordenado por 'start' y luego 'end').
+ * Además guarda 'maxEnd': el mayor 'end' de todo su subárbol.
+ */
+struct Node {
+    Interval interval; // La llave
+    int maxEnd;        // Máximo 'end' del subárbol (aumento)
+    int priority;      // Prioridad aleatoria (valor del MaxHeap)
+    Node *left, *right;
+
+    // Constructor: asigna el intervalo y una prioridad aleatoria
+    Node(Interval i) {
+        interval = i;
+        maxEnd = i.end;
+        priority = rand();
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/**
+ * @brief Árbol de intervalos construido sobre un Treap.
+ * Permite encontrar todos los intervalos que se solapan con un punto
+ * o con un rango sin recorrer la estructura completa.
+ */
+class IntervalTreap {
+private:
+    Node* root;    // Raíz del árbol
+    int nodeCount; // Cantidad de intervalos
+
+    // Orden del BST: primero por 'start', luego por 'end'
+    static bool less(const Interval& a, const Interval& b) {
+        return a.start < b.start || (a.start == b.start && a.end < b.end);
+    }
+
+    static bool same(const Interval& a, const Interval& b) {
+        return a.start == b.start && a.end == b.end;
+    }
+
+    // Recalcula 'maxEnd' a partir de los hijos
+    static void update(Node* node) {
+        node->maxEnd = node->interval.end;
+        if (node->left != nullptr && node->left->maxEnd > node->maxEnd) {
+            node->maxEnd = node->left->maxEnd;
+        }
+        if (node->right != nullptr && node->right->maxEnd > node->maxEnd) {
+            node->maxEnd = node->right->maxEnd;
+        }
+    }
+
+    // --- Funciones de Rotación ---
+    // Idénticas a las de TreapSet, pero mantienen 'maxEnd':
+    // primero el nodo que baja y luego el que sube.
+
+    Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Ayudante recursivo para insertar un intervalo.
+     * Si el intervalo exacto ya existe, no hace nada.
+     */
+    Node* insertRecursive(Node* node, Interval interval) {
+        if (node == nullptr) {
+            nodeCount++;
+            return new Node(interval);
+        }
+
+        if (less(interval, node->interval)) {
+            node->left = insertRecursive(node->left, interval);
+            if (node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (less(node->interval, interval)) {
+            node->right = insertRecursive(node->right, interval);
+            if (node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        }
+        // Si es el mismo intervalo, no hacemos nada.
+
+        update(node);
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para eliminar un intervalo.
+     * Lógica idéntica a TreapSet (rotar hacia abajo hasta tener < 2 hijos).
+     */
+    Node* removeRecursive(Node* node, Interval interval) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (less(interval, node->interval)) {
+            node->left = removeRecursive(node->left, interval);
+        } else if (less(node->interval, interval)) {
+            node->right = removeRecursive(node->right, interval);
+        } else {
+            // --- Nodo encontrado ---
+            if (node->left == nullptr) {
+                Node* temp = node->right;
+                delete node;
+                nodeCount--;
+                return temp;
+            } else if (node->right == nullptr) {
+                Node* temp = node->left;
+                delete node;
+                nodeCount--;
+                return temp;
+            }
+
+            // 2 hijos: rotar
+            if (node->left->priority > node->right->priority) {
+                node = rotateRight(node);
+                node->right = removeRecursive(node->right, interval);
+            } else {
+                node = rotateLeft(node);
+                node->left = removeRecursive(node->left, interval);
+            }
+        }
+        update(node);
+        return node;
+    }
+
+    bool containsRecursive(Node* node, Interval interval) {
+        if (node == nullptr) {
+            return false;
+        }
+        if (same(interval, node->interval)) {
+            return true;
+        }
+        if (less(interval, node->interval)) {
+            return containsRecursive(node->left, interval);
+        } else {
+            return containsRecursive(node->right, interval);
+        }
+    }
+
+    /**
+     * @brief Ayudante recursivo para overlapping().
+     * Poda de dos formas:
+     * - Si maxEnd < lo, ningún intervalo del subárbol llega hasta 'lo'.
+     * - Si start > hi, ni este nodo ni su rama derecha empiezan a tiempo.
+     * Así solo se visitan caminos que llevan a algún resultado.
+     */
+    void overlappingRecursive(Node* node, int lo, int hi, vector<Interval>& out) {
+        if (node == nullptr || node->maxEnd < lo) {
+            return;
+        }
+        overlappingRecursive(node->left, lo, hi, out);
+        if (node->interval.start > hi) {
+            return;
+        }
+        if (node->interval.end >= lo) {
+            out.push_back(node->interval);
+        }
+        overlappingRecursive(node->right, lo, hi, out);
+    }
+
+    // Libera toda la memoria del árbol
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de un árbol vacío
+    IntervalTreap() {
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Destructor
+    ~IntervalTreap() {
+        clear();
+    }
+
+    // Vacía el árbol
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Retorna la cantidad de intervalos guardados
+    int size() {
+        return nodeCount;
+    }
+
+    // Adiciona el intervalo [start, end]
+    void insert(int start, int end) {
+        Interval interval = {start, end};
+        root = insertRecursive(root, interval);
+    }
+
+    // Retira el intervalo [start, end] (si existe)
+    void remove(int start, int end) {
+        Interval interval = {start, end};
+        root = removeRecursive(root, interval);
+    }
+
+    // Retorna si el intervalo exacto [start, end] está guardado
+    bool contains(int start, int end) {
+        Interval interval = {start, end};
+        return containsRecursive(root, interval);
+    }
+
+    // Intervalos que contienen al punto 'point', ordenados por inicio
+    vector<Interval> overlapping(int point) {
+        return overlapping(point, point);
+    }
+
+    // Intervalos que se solapan con [lo, hi], ordenados por inicio
+    vector<Interval> overlapping(int lo, int hi) {
+        vector<Interval> out;
+        overlappingRecursive(root, lo, hi, out);
+        return out;
+    }
+};
+
+// Imprime una lista de intervalos
+void printIntervals(const vector<Interval>& list) {
+    for (size_t i = 0; i < list.size(); i++) {
+        cout << "[" << list[i].start << ", " << list[i].end << "] ";
+    }
+    cout << endl;
+}
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de IntervalTreap (rangos de tiempo) ---" << endl;
+    IntervalTreap agenda;
+
+    // insert
+    agenda.insert(8, 10);
+    agenda.insert(9, 12);
+    agenda.insert(13, 15);
+    agenda.insert(1, 20);
+    agenda.insert(16, 18);
+
+    cout << "Insertando [8,10], [9,12], [13,15], [1,20], [16,18]..." << endl;
+    cout << "size(): " << agenda.size() << endl;
+
+    // overlapping(point)
+    cout << "overlapping(9): ";
+    printIntervals(agenda.overlapping(9));
+
+    // overlapping(lo, hi)
+    cout << "overlapping(14, 16): ";
+    printIntervals(agenda.overlapping(14, 16));
+
+    // remove
+    agenda.remove(1, 20);
+    cout << "remove([1,20])..." << endl;
+    cout << "overlapping(14, 16): ";
+    printIntervals(agenda.overlapping(14, 16));
+    cout << "contains([1,20])? " << (agenda.contains(1, 20) ? "Si" : "No") << endl;
+
+    return 0;
+}
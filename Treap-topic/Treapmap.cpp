@@ -2,6 +2,27 @@
 #include <string>  // Para usar std::string
 #include <cstdlib> // Para rand() y srand()
 #include <ctime>   // Para time()
+#include <cstdint> // Para uint64_t
+#include <vector>  // Para los bloques del filtro
+#include <limits>  // Para numeric_limits (neutros de min/max)
+#include <thread>  // Para liberar memoria en segundo plano
+#include <mutex>   // Para la cola del hilo liberador
+#include <condition_variable>
+#include <queue>   // Para el índice de vencimientos (priority_queue)
+#include <climits> // Para LLONG_MAX
+#include <fstream> // Para el archivo de traza
+#include <cstdio>  // Para remove() del archivo de ejemplo
+#include <cstring> // Para memset()
+#include <chrono>  // Para medir la repetición de una traza
+#ifdef __GLIBC__
+#include <malloc.h> // Para malloc_usable_size()
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h> // Contadores de hardware (ciclos, instrucciones)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -10,50 +31,534 @@ using namespace std;
 typedef int Key;
 typedef string Value;
 
+// Instante de vencimiento de una entrada (unidades a elección del usuario)
+typedef long long Time;
+const Time NO_DEADLINE = LLONG_MAX; // La entrada nunca vence
+
+/**
+ * @brief Política de aumento: resumen por subárbol (un monoide).
+ * Cada nodo guarda el resumen de TODO su subárbol, así una consulta
+ * de rango combina O(log n) resúmenes en vez de recorrer el rango.
+ *
+ * Para agregar otra cosa basta con escribir otra política con la misma
+ * forma y pasarla como parámetro del mapa (TreapMap<MiPolitica>):
+ * - enabled:          true (solo NoAugment lo tiene en false)
+ * - Summary:          tipo del resumen
+ * - identity():       elemento neutro (subárbol vacío)
+ * - lift(key, value): resumen de un solo par
+ * - combine(a, b):    operación asociativa (a = parte izquierda)
+ */
+struct StatsPolicy {
+    static const bool enabled = true;
+
+    struct Summary {
+        int count;       // Cantidad de pares
+        double sum;      // Suma de la métrica
+        double min;      // Mínimo de la métrica
+        double max;      // Máximo de la métrica
+        int countWhere;  // Pares que cumplen el predicado
+    };
+
+    // Métrica numérica de un valor. Como Value es string, usamos su longitud.
+    static double metric(const Value& value) {
+        return (double)value.size();
+    }
+
+    // Predicado para countWhere: valores no vacíos
+    static bool predicate(Key, const Value& value) {
+        return !value.empty();
+    }
+
+    static Summary identity() {
+        Summary s;
+        s.count = 0;
+        s.sum = 0.0;
+        s.min = numeric_limits<double>::infinity();
+        s.max = -numeric_limits<double>::infinity();
+        s.countWhere = 0;
+        return s;
+    }
+
+    static Summary lift(Key key, const Value& value) {
+        double m = metric(value);
+        Summary s;
+        s.count = 1;
+        s.sum = m;
+        s.min = m;
+        s.max = m;
+        s.countWhere = predicate(key, value) ? 1 : 0;
+        return s;
+    }
+
+    static Summary combine(const Summary& a, const Summary& b) {
+        Summary s;
+        s.count = a.count + b.count;
+        s.sum = a.sum + b.sum;
+        s.min = a.min < b.min ? a.min : b.min;
+        s.max = a.max > b.max ? a.max : b.max;
+        s.countWhere = a.countWhere + b.countWhere;
+        return s;
+    }
+};
+
+/**
+ * @brief Política vacía (la de por defecto): sin resumen por subárbol.
+ * Con ella los nodos no guardan nada extra y aggregate() no existe.
+ */
+struct NoAugment {
+    static const bool enabled = false;
+
+    struct Summary {};
+
+    static Summary identity() { return Summary(); }
+    static Summary lift(Key, const Value&) { return Summary(); }
+    static Summary combine(const Summary&, const Summary&) { return Summary(); }
+};
+
+// Lugar del resumen dentro del nodo; vacío (0 bytes, es una base) sin política
+template <class Augment, bool = Augment::enabled>
+struct AugmentSlot {
+    typename Augment::Summary agg; // Resumen del subárbol que cuelga de este nodo
+};
+
+template <class Augment>
+struct AugmentSlot<Augment, false> {};
+
 /**
  * @brief Nodo para el TreapMap.
- * Almacena llave, valor asociado y prioridad.
+ * Almacena llave, valor asociado, prioridad, el tamaño de su subárbol
+ * y (si hay política) el resumen de la política de aumento.
  */
-struct Node {
+template <class Augment>
+struct TreapNode : AugmentSlot<Augment> {
     Key key;
-    Value value;
     int priority;
-    Node *left, *right;
+    int size;             // Nodos del subárbol (independiente de la política)
+    bool dirty;           // size/agg pendientes de recalcular (ver TreapMap::update)
+    Time deadline;        // Instante en que la entrada vence
+    Value value;
+    TreapNode *left, *right;
 
-    // Constructor: asigna llave, valor y prioridad aleatoria
-    Node(Key k, Value v) {
+    // Constructor: asigna llave, valor, vencimiento y prioridad aleatoria
+    TreapNode(Key k, Value v, Time d) {
         key = k;
         value = v;
         priority = rand();
+        size = 1;
+        dirty = false;
+        deadline = d;
+        if constexpr (Augment::enabled) {
+            this->agg = Augment::lift(k, value);
+        }
         left = nullptr;
         right = nullptr;
     }
 };
 
+/**
+ * @brief Filtro de Bloom por bloques (blocked Bloom filter).
+ * Cada llave se asigna a UN bloque de 64 bytes (una línea de caché)
+ * y enciende un bit en cada una de sus 8 palabras.
+ * - Si algún bit está apagado, la llave seguro NO está.
+ * - Si todos están encendidos, la llave "quizás" está.
+ * No admite borrado: los bits viejos solo producen falsos positivos.
+ */
+struct BlockedBloomFilter {
+    struct alignas(64) Block {
+        uint64_t words[8]; // 512 bits = una línea de caché
+    };
+
+    std::vector<Block> blocks;
+
+    // Reserva ~16 bits por llave esperada (falsos positivos < 1%)
+    void reset(int expectedKeys) {
+        size_t count = ((size_t)expectedKeys * 16 + 511) / 512;
+        if (count == 0) count = 1;
+        blocks.assign(count, Block());
+    }
+
+    void add(Key key) {
+        uint64_t h = hash(key);
+        Block& b = blocks[blockIndex(h)];
+        for (int i = 0; i < 8; i++) {
+            b.words[i] |= bitMask(h, i);
+        }
+    }
+
+    bool mayContain(Key key) const {
+        uint64_t h = hash(key);
+        const Block& b = blocks[blockIndex(h)];
+        for (int i = 0; i < 8; i++) {
+            if ((b.words[i] & bitMask(h, i)) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // Mezcla de bits (splitmix64) para que llaves consecutivas se dispersen
+    static uint64_t hash(Key key) {
+        uint64_t z = (uint64_t)(int64_t)key + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Parte alta del hash -> bloque (sin usar '%')
+    size_t blockIndex(uint64_t h) const {
+        return (size_t)(((h >> 32) * (uint64_t)blocks.size()) >> 32);
+    }
+
+    // Parte baja del hash * "sal" distinta por palabra -> bit de 0 a 63
+    static uint64_t bitMask(uint64_t h, int i) {
+        static const uint32_t SALT[8] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+            0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+        };
+        uint32_t x = (uint32_t)h * SALT[i];
+        return 1ULL << (x >> 26);
+    }
+};
+
+/**
+ * @brief Libera árboles grandes con un grupo de hilos compartido por todo
+ * el programa (se crea la primera vez que hace falta y nunca se destruye).
+ * - freeTree(): libera ya. Corta la cima del árbol en trozos, los pone en
+ *   la cola, y quien llama libera uno y ayuda con los suyos que queden.
+ * - submit(): entrega una raíz y retorna de inmediato, sin esperar a nadie.
+ * Ningún destructor hace join: los hilos viven lo mismo que el proceso.
+ */
+class NodeReclaimer {
+private:
+    typedef void (*FreeFn)(void* root);
+
+    struct Job {
+        void* root;
+        FreeFn free;     // Sabe de qué tipo de nodo es 'root'
+        int* remaining;  // Contador del freeTree() que espera (nullptr si nadie)
+    };
+
+    mutex lock;
+    condition_variable wake;  // Hay trabajos en la cola
+    condition_variable done;  // Terminó un trabajo (para freeTree y drain)
+    vector<Job> jobs;
+    int running;              // Trabajos en curso en los hilos
+    bool started;             // Los hilos se crean la primera vez que hacen falta
+
+    // Subárboles con menos nodos que esto se liberan en un solo hilo
+    static const int PARALLEL_CUTOFF = 1 << 14;
+
+    NodeReclaimer() {
+        running = 0;
+        started = false;
+    }
+
+    static int poolSize() {
+        unsigned cores = thread::hardware_concurrency();
+        return cores > 1 ? (int)cores : 1;
+    }
+
+    // Niveles de la cima a cortar: unos 4 trozos por hilo
+    static int splitDepth() {
+        int depth = 0;
+        while ((1 << depth) < 4 * poolSize()) {
+            depth++;
+        }
+        return depth;
+    }
+
+    template <class Node>
+    static void freeSerial(void* root) {
+        Node* node = (Node*)root;
+        if (node != nullptr) {
+            freeSerial<Node>(node->left);
+            freeSerial<Node>(node->right);
+            delete node;
+        }
+    }
+
+    /**
+     * @brief Borra los nodos de la cima (hasta 'depth' niveles) y deja en
+     * 'pieces' los subárboles que colgaban de ellos. Si un nodo quedó sucio
+     * su 'size' es aproximado; solo decide dónde cortar.
+     */
+    template <class Node>
+    static void splitTop(Node* node, int depth, vector<Node*>& pieces) {
+        if (node == nullptr) {
+            return;
+        }
+        if (depth == 0 || node->size < PARALLEL_CUTOFF) {
+            pieces.push_back(node);
+            return;
+        }
+        splitTop(node->left, depth - 1, pieces);
+        splitTop(node->right, depth - 1, pieces);
+        delete node;
+    }
+
+    // Trabajo que deja submit(): cortar el árbol y encolar los trozos
+    template <class Node>
+    static void scatter(void* root) {
+        vector<Node*> pieces;
+        splitTop((Node*)root, splitDepth(), pieces);
+        shared().enqueue(pieces, 0, nullptr);
+    }
+
+    template <class Node>
+    void enqueue(const vector<Node*>& pieces, size_t first, int* remaining) {
+        {
+            lock_guard<mutex> guard(lock);
+            startWorkers();
+            for (size_t i = first; i < pieces.size(); i++) {
+                Job job = {pieces[i], &freeSerial<Node>, remaining};
+                jobs.push_back(job);
+            }
+        }
+        wake.notify_all();
+    }
+
+    // Se llama con 'lock' tomado
+    void startWorkers() {
+        if (!started) {
+            started = true;
+            for (int i = 0; i < poolSize(); i++) {
+                thread(&NodeReclaimer::run, this).detach();
+            }
+        }
+    }
+
+    void run() {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [this] { return !jobs.empty(); });
+            Job job = jobs.back();
+            jobs.pop_back();
+            running++;
+            guard.unlock();
+            job.free(job.root);
+            guard.lock();
+            running--;
+            if (job.remaining != nullptr) {
+                (*job.remaining)--;
+            }
+            done.notify_all();
+        }
+    }
+
+public:
+    // Instancia única; nunca se destruye, así que sus hilos no se esperan al salir
+    static NodeReclaimer& shared() {
+        static NodeReclaimer* instance = new NodeReclaimer();
+        return *instance;
+    }
+
+    // Libera el árbol ya, repartiendo los trozos entre los hilos del grupo
+    template <class Node>
+    void freeTree(Node* root) {
+        if (root == nullptr) {
+            return;
+        }
+        if (root->size < PARALLEL_CUTOFF || poolSize() == 1) {
+            freeSerial<Node>(root);
+            return;
+        }
+        vector<Node*> pieces;
+        splitTop(root, splitDepth(), pieces);
+        if (pieces.empty()) {
+            return;
+        }
+        int remaining = (int)pieces.size() - 1;
+        enqueue(pieces, 1, &remaining);
+        freeSerial<Node>(pieces[0]);
+
+        // Ayudar con los trozos propios que sigan en la cola
+        unique_lock<mutex> guard(lock);
+        while (remaining > 0) {
+            size_t i = jobs.size();
+            while (i > 0 && jobs[i - 1].remaining != &remaining) {
+                i--;
+            }
+            if (i == 0) {
+                done.wait(guard); // Los que faltan ya están en otros hilos
+                continue;
+            }
+            Job job = jobs[i - 1];
+            jobs.erase(jobs.begin() + (i - 1));
+            guard.unlock();
+            job.free(job.root);
+            guard.lock();
+            remaining--;
+        }
+    }
+
+    // Entrega el árbol al grupo de hilos y retorna sin esperar
+    template <class Node>
+    void submit(Node* root) {
+        if (root == nullptr) {
+            return;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            startWorkers();
+            Job job = {root, &scatter<Node>, nullptr};
+            jobs.push_back(job);
+        }
+        wake.notify_one();
+    }
+
+    // Espera a que todo lo entregado (por cualquier mapa) se haya liberado
+    void drain() {
+        unique_lock<mutex> guard(lock);
+        done.wait(guard, [this] { return jobs.empty() && running == 0; });
+    }
+};
+
+/**
+ * @brief Reporte de memoria de un TreapMap (todo en bytes).
+ */
+struct MemoryUsage {
+    size_t nodes;             // Cantidad de nodos
+    size_t nodeBytes;         // nodes * sizeof(Node)
+    size_t valueHeapBytes;    // Bytes de strings que no caben en el objeto (SSO)
+    size_t auxiliaryBytes;    // Filtro de Bloom + heap de vencimientos
+    size_t allocatorOverhead; // Cabeceras y redondeo del malloc
+    size_t total;             // Suma de todo lo anterior
+    double fragmentation;     // allocatorOverhead / total (0 = nada perdido)
+};
+
 /**
  * @brief Implementa el concepto de Asociación (Mapa) usando un Treap.
- * 
+ * 'Augment' es la política de resúmenes por subárbol; la de por defecto
+ * (NoAugment) no agrega nada a los nodos.
  */
+template <class Augment = NoAugment>
 class TreapMap {
 private:
-    Node* root; // Raíz del árbol
+    typedef TreapNode<Augment> Node;
+    typedef typename Augment::Summary Summary;
+
+public:
+    /**
+     * @brief Un paso del camino guardado en un Finger: el nodo y el rango
+     * abierto (lo, hi) de llaves que puede contener su subárbol.
+     */
+    struct FingerStep {
+        Node* node;
+        Key lo, hi;
+        bool hasLo, hasHi; // false = sin límite por ese lado
+
+        bool covers(Key key) const {
+            return (!hasLo || lo < key) && (!hasHi || key < hi);
+        }
+    };
+
+    /**
+     * @brief "Dedo" (finger): recuerda el camino desde la raíz hasta el
+     * último nodo tocado. Con llaves casi ordenadas, la siguiente operación
+     * sube solo hasta el ancestro cuyo rango cubre la llave nueva y baja
+     * desde ahí: O(log d) comparaciones, con d la distancia en rango.
+     * Si el árbol cambió de forma (rotaciones, borrados) el dedo se descarta
+     * y se empieza desde la raíz.
+     */
+    struct Finger {
+        vector<FingerStep> path;
+        long long version; // Versión de la forma del árbol al armar el camino
+
+        Finger() {
+            version = -1;
+        }
+    };
+
+private:
+    Node* root;    // Raíz del árbol
+    int nodeCount; // Cantidad de llaves guardadas
+
+    // --- Filtro de pertenencia (opcional) ---
+    // Rechaza la mayoría de búsquedas fallidas sin recorrer el árbol.
+    bool filterEnabled;
+    BlockedBloomFilter filter;
+    int filterCapacity;  // Llaves para las que se dimensionó el filtro
+    int staleRemovals;   // Llaves removidas que siguen marcadas en el filtro
+
+    // --- Modo auto-ajustable ---
+    // Si está activo, cada búsqueda exitosa puede subir la prioridad del
+    // nodo encontrado, y las llaves más consultadas "flotan" hacia la raíz.
+    bool selfAdjusting;
+
+    // --- Liberación de memoria ---
+    // Los 'delete' de subárboles retirados (rangos, clear) van al
+    // NodeReclaimer compartido.
+    bool asyncTeardown; // clear() entrega el árbol y retorna de inmediato
+
+    // --- Vencimientos (TTL) ---
+    // MinHeap de (vencimiento, llave). Las entradas viejas (llave removida
+    // o con otro vencimiento) no se borran del heap: se descartan al salir.
+    typedef pair<Time, Key> Deadline;
+    priority_queue<Deadline, vector<Deadline>, greater<Deadline> > deadlines;
+    Time clockNow; // Último instante conocido; lo que vence antes está "ausente"
+
+    // Cambia cada vez que el árbol cambia de forma; invalida los Finger
+    long long shapeVersion;
+
+    // --- Resúmenes de subárbol ---
+    // Se mantienen al día en cada rotación, split y join. La inserción con
+    // dedo, en cambio, solo marca como sucios a los ancestros (parando en el
+    // primero que ya lo estaba), así que un nodo sucio siempre tiene a todos
+    // sus ancestros sucios. Los nodos sucios se recalculan cuando alguien los
+    // necesita: update() de un padre, o aggregate() desde la raíz.
+
+    static Summary aggOf(Node* node) {
+        return node == nullptr ? Augment::identity() : node->agg;
+    }
+
+    static int sizeOf(Node* node) {
+        return node == nullptr ? 0 : node->size;
+    }
+
+    // Recalcula 'node' si quedó sucio; un nodo limpio tiene todo su subárbol limpio
+    static void clean(Node* node) {
+        if (node != nullptr && node->dirty) {
+            update(node);
+        }
+    }
+
+    // Recalcula el tamaño y el resumen de 'node' a partir de sus hijos
+    static void update(Node* node) {
+        clean(node->left);
+        clean(node->right);
+        node->dirty = false;
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        if constexpr (Augment::enabled) {
+            node->agg = Augment::combine(
+                Augment::combine(aggOf(node->left), Augment::lift(node->key, node->value)),
+                aggOf(node->right));
+        }
+    }
 
     // --- Funciones de Rotación ---
-    // Idénticas a las de TreapSet.
+    // Idénticas a las de TreapSet, pero actualizan los resúmenes:
+    // primero el nodo que baja y luego el que sube.
 
     Node* rotateRight(Node* y) {
+        shapeVersion++;
         Node* x = y->left;
         Node* T2 = x->right;
         x->right = y;
         y->left = T2;
+        update(y);
+        update(x);
         return x;
     }
 
     Node* rotateLeft(Node* x) {
+        shapeVersion++;
         Node* y = x->right;
         Node* T2 = y->left;
         y->left = x;
         x->right = T2;
+        update(x);
+        update(y);
         return y;
     }
 
@@ -63,30 +568,33 @@ private:
      * @brief Ayudante recursivo para insertar (llave, valor).
      * Si la llave ya existe, actualiza el valor.
      */
-    Node* insertRecursive(Node* node, Key key, Value value) {
+    Node* insertRecursive(Node* node, Key key, Value value, Time deadline) {
         // 1. Caso base: Insertar nuevo nodo
         if (node == nullptr) {
-            return new Node(key, value);
+            nodeCount++;
+            return new Node(key, value, deadline);
         }
 
         // 2. Bajar por el árbol (Propiedad BST)
         if (key < node->key) {
-            node->left = insertRecursive(node->left, key, value);
+            node->left = insertRecursive(node->left, key, value, deadline);
             // 3. Chequear propiedad MaxHeap
             if (node->left != nullptr && node->left->priority > node->priority) {
                 node = rotateRight(node);
             }
         } else if (key > node->key) {
-            node->right = insertRecursive(node->right, key, value);
+            node->right = insertRecursive(node->right, key, value, deadline);
             // 3. Chequear propiedad MaxHeap
             if (node->right != nullptr && node->right->priority > node->priority) {
                 node = rotateLeft(node);
             }
         } else {
-            // Llave encontrada: actualizar el valor
+            // Llave encontrada: actualizar el valor (y su vencimiento)
             node->value = value;
+            node->deadline = deadline;
         }
-        
+
+        update(node);
         return node;
     }
 
@@ -108,10 +616,16 @@ private:
             if (node->left == nullptr) {
                 Node* temp = node->right;
                 delete node;
+                nodeCount--;
+                shapeVersion++;
+                staleRemovals++;
                 return temp;
             } else if (node->right == nullptr) {
                 Node* temp = node->left;
                 delete node;
+                nodeCount--;
+                shapeVersion++;
+                staleRemovals++;
                 return temp;
             }
             
@@ -124,6 +638,7 @@ private:
                 node->left = removeRecursive(node->left, key);
             }
         }
+        update(node);
         return node;
     }
 
@@ -145,35 +660,429 @@ private:
         }
     }
 
-    // Libera toda la memoria
+    /**
+     * @brief Búsqueda que además ajusta el árbol (modo auto-ajustable).
+     * Al encontrar la llave se sortea una prioridad nueva y el nodo se
+     * queda con la mayor de las dos. Tras k accesos su prioridad es el
+     * máximo de k+1 sorteos, así que los nodos frecuentes suben solos.
+     * De regreso se rota como en insertRecursive para restaurar el MaxHeap.
+     */
+    Node* accessRecursive(Node* node, Key key, Node*& found) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (key < node->key) {
+            node->left = accessRecursive(node->left, key, found);
+            if (node->left != nullptr && node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (key > node->key) {
+            node->right = accessRecursive(node->right, key, found);
+            if (node->right != nullptr && node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        } else {
+            found = node;
+            int bump = rand();
+            if (bump > node->priority) {
+                node->priority = bump;
+            }
+        }
+        return node;
+    }
+
+    // Punto único de búsqueda para find() y contains()
+    Node* lookup(Key key) {
+        Node* found = nullptr;
+        if (!selfAdjusting) {
+            found = findNode(root, key);
+        } else {
+            root = accessRecursive(root, key, found);
+        }
+        // Vencida pero aún no purgada: se trata como ausente (perezoso)
+        if (found != nullptr && found->deadline <= clockNow) {
+            return nullptr;
+        }
+        return found;
+    }
+
+    // Vuelve a llenar el heap de vencimientos con los nodos del subárbol
+    void collectDeadlines(Node* node) {
+        if (node != nullptr) {
+            if (node->deadline != NO_DEADLINE) {
+                deadlines.push(Deadline(node->deadline, node->key));
+            }
+            collectDeadlines(node->left);
+            collectDeadlines(node->right);
+        }
+    }
+
+    /**
+     * @brief Compacta el heap cuando acumula demasiadas entradas viejas
+     * (llaves que se reinsertaron o removieron antes de vencer).
+     */
+    void compactDeadlines() {
+        if (deadlines.size() > 2 * (size_t)nodeCount + 64) {
+            deadlines = priority_queue<Deadline, vector<Deadline>, greater<Deadline> >();
+            collectDeadlines(root);
+        }
+    }
+
+    /**
+     * @brief Ayudante recursivo para aggregate().
+     * 'hasLo'/'hasHi' indican si ese límite aún restringe al subárbol.
+     * Una vez que el nodo cae dentro del rango, su rama izquierda solo
+     * depende de 'lo' y la derecha solo de 'hi', así que cada camino
+     * tiene un solo límite y el costo total es O(log n).
+     */
+    Summary aggregateRecursive(Node* node, Key lo, Key hi, bool hasLo, bool hasHi) {
+        if (node == nullptr) {
+            return Augment::identity();
+        }
+        if (!hasLo && !hasHi) {
+            return node->agg; // Subárbol completo dentro del rango
+        }
+        if (hasLo && node->key < lo) {
+            return aggregateRecursive(node->right, lo, hi, hasLo, hasHi);
+        }
+        if (hasHi && !(node->key < hi)) {
+            return aggregateRecursive(node->left, lo, hi, hasLo, hasHi);
+        }
+        Summary leftPart = aggregateRecursive(node->left, lo, hi, hasLo, false);
+        Summary rightPart = aggregateRecursive(node->right, lo, hi, false, hasHi);
+        return Augment::combine(
+            Augment::combine(leftPart, Augment::lift(node->key, node->value)),
+            rightPart);
+    }
+
+    /**
+     * @brief Parte el subárbol en 'left' (llaves < key) y 'right'
+     * (llaves >= key), actualizando los resúmenes del camino. O(log n).
+     */
+    void split(Node* node, Key key, Node*& left, Node*& right) {
+        if (node == nullptr) {
+            left = nullptr;
+            right = nullptr;
+            return;
+        }
+        if (node->key < key) {
+            split(node->right, key, node->right, right);
+            left = node;
+        } else {
+            split(node->left, key, left, node->left);
+            right = node;
+        }
+        update(node);
+    }
+
+    /**
+     * @brief Une dos treaps donde todas las llaves de 'left' son menores
+     * que las de 'right'. Sube la raíz de mayor prioridad. O(log n).
+     */
+    Node* join(Node* left, Node* right) {
+        if (left == nullptr) return right;
+        if (right == nullptr) return left;
+        if (left->priority > right->priority) {
+            left->right = join(left->right, right);
+            update(left);
+            return left;
+        } else {
+            right->left = join(left, right->left);
+            update(right);
+            return right;
+        }
+    }
+
+    /**
+     * @brief Separa del árbol las llaves en [lo, hi) con dos splits
+     * y un join. Retorna la raíz del subárbol separado; su tamaño
+     * ya viene en el nodo, así que no hay que recorrerlo.
+     */
+    Node* cutRange(Key lo, Key hi) {
+        shapeVersion++;
+        Node *before, *rest, *middle, *after;
+        split(root, lo, before, rest);
+        split(rest, hi, middle, after);
+        root = join(before, after);
+        int removed = sizeOf(middle);
+        nodeCount -= removed;
+        staleRemovals += removed;
+        return middle;
+    }
+
+    /**
+     * @brief Mueve el dedo hasta 'key': sube mientras el rango del paso
+     * actual no cubra la llave y luego baja como en un BST, guardando
+     * cada paso. Termina en el nodo con esa llave (y lo retorna) o en el
+     * último nodo visitado (y retorna nullptr).
+     */
+    Node* seek(Finger& finger, Key key) {
+        if (finger.version != shapeVersion || finger.path.empty()
+            || finger.path[0].node != root) {
+            finger.path.clear();
+            finger.version = shapeVersion;
+            if (root == nullptr) {
+                return nullptr;
+            }
+            FingerStep top = {root, Key(), Key(), false, false};
+            finger.path.push_back(top);
+        }
+
+        // 1. Subir hasta el ancestro que cubre la llave (la raíz cubre todo)
+        while (finger.path.size() > 1 && !finger.path.back().covers(key)) {
+            finger.path.pop_back();
+        }
+
+        // 2. Bajar desde ahí
+        while (true) {
+            FingerStep step = finger.path.back();
+            if (key == step.node->key) {
+                return step.node;
+            }
+            FingerStep next = step;
+            if (key < step.node->key) {
+                next.node = step.node->left;
+                next.hi = step.node->key;
+                next.hasHi = true;
+            } else {
+                next.node = step.node->right;
+                next.lo = step.node->key;
+                next.hasLo = true;
+            }
+            if (next.node == nullptr) {
+                return nullptr;
+            }
+            finger.path.push_back(next);
+        }
+    }
+
+    // Marca como sucios path[from], path[from - 1], ... hasta uno ya sucio
+    static void markDirty(vector<FingerStep>& path, int from) {
+        for (int i = from; i >= 0 && !path[i].node->dirty; i--) {
+            path[i].node->dirty = true;
+        }
+    }
+
+    // Libera toda la memoria (en paralelo si el árbol es grande)
     void clearRecursive(Node* node) {
+        if (asyncTeardown) {
+            NodeReclaimer::shared().submit(node);
+        } else {
+            NodeReclaimer::shared().freeTree(node);
+        }
+    }
+
+    /**
+     * @brief Libera un subárbol en el hilo liberador, para que quien
+     * llamó no pague el costo de los 'delete'.
+     */
+    void deferFree(Node* subtree) {
+        NodeReclaimer::shared().submit(subtree);
+    }
+
+    // Constructor privado: envuelve un subárbol ya armado
+    explicit TreapMap(Node* subtree) : TreapMap() {
+        root = subtree;
+        nodeCount = sizeOf(subtree);
+    }
+
+    // Igual, pero conserva el reloj y los vencimientos del mapa de origen
+    TreapMap(Node* subtree, Time now, bool hasDeadlines) : TreapMap(subtree) {
+        clockNow = now;
+        if (hasDeadlines) {
+            collectDeadlines(root);
+        }
+    }
+
+    // Vuelve a marcar en el filtro todas las llaves del subárbol
+    void fillFilter(Node* node) {
         if (node != nullptr) {
-            clearRecursive(node->left);
-            clearRecursive(node->right);
-            delete node;
+            filter.add(node->key);
+            fillFilter(node->left);
+            fillFilter(node->right);
         }
     }
 
+    /**
+     * @brief Reconstruye el filtro si quedó "sucio".
+     * Se hace de forma perezosa (en la siguiente búsqueda) cuando:
+     * - Hay muchas llaves removidas aún marcadas (más falsos positivos), o
+     * - El mapa creció más allá de la capacidad del filtro.
+     */
+    void refreshFilter() {
+        if (staleRemovals > nodeCount / 2 + 16 || nodeCount > filterCapacity) {
+            filterCapacity = nodeCount * 2 > 64 ? nodeCount * 2 : 64;
+            filter.reset(filterCapacity);
+            fillFilter(root);
+            staleRemovals = 0;
+        }
+    }
+
+    // true si la llave seguro NO está (no hace falta recorrer el árbol)
+    bool filterRejects(Key key) {
+        if (!filterEnabled) {
+            return false;
+        }
+        refreshFilter();
+        return !filter.mayContain(key);
+    }
+
 public:
     // Constructor de un mapa vacío [cite: 83]
     TreapMap() {
         root = nullptr;
+        nodeCount = 0;
+        filterEnabled = false;
+        filterCapacity = 0;
+        staleRemovals = 0;
+        selfAdjusting = false;
+        clockNow = LLONG_MIN;
+        shapeVersion = 0;
+        asyncTeardown = false;
+    }
+
+    // Constructor de movimiento: se adueña del árbol (y filtro) de 'other'
+    TreapMap(TreapMap&& other) : TreapMap() {
+        root = other.root;
+        nodeCount = other.nodeCount;
+        filterEnabled = other.filterEnabled;
+        filter = move(other.filter);
+        filterCapacity = other.filterCapacity;
+        staleRemovals = other.staleRemovals;
+        selfAdjusting = other.selfAdjusting;
+        asyncTeardown = other.asyncTeardown;
+        deadlines = move(other.deadlines);
+        clockNow = other.clockNow;
+        other.shapeVersion++;
+        other.root = nullptr;
+        other.nodeCount = 0;
+        other.filterEnabled = false;
     }
 
     // Destructor [cite: 83]
+    // (con asyncTeardown solo entrega el árbol; no espera a que se libere)
     ~TreapMap() {
         clear();
     }
 
+    /**
+     * @brief Si está activo, clear() (y el destructor) le entregan el árbol
+     * al hilo liberador en vez de hacer los 'delete' en el hilo que llama.
+     */
+    void setAsyncTeardown(bool enabled) {
+        asyncTeardown = enabled;
+    }
+
+    // Espera a que los hilos liberadores terminen lo pendiente (de todos los mapas)
+    static void waitForTeardown() {
+        NodeReclaimer::shared().drain();
+    }
+
     // Vacía el mapa
     void clear() {
+        shapeVersion++;
         clearRecursive(root);
         root = nullptr;
+        nodeCount = 0;
+        staleRemovals = 0;
+        deadlines = priority_queue<Deadline, vector<Deadline>, greater<Deadline> >();
+        if (filterEnabled) {
+            filter.reset(filterCapacity);
+        }
+    }
+
+    // Retorna la cantidad de llaves del mapa
+    int size() {
+        return nodeCount;
+    }
+
+    /**
+     * @brief Activa el filtro de Bloom frente a las búsquedas.
+     * 'expectedKeys' es una estimación del tamaño final; si el mapa
+     * crece más, el filtro se redimensiona solo.
+     */
+    void enableFilter(int expectedKeys = 0) {
+        filterEnabled = true;
+        filterCapacity = -1; // Fuerza la reconstrucción
+        if (expectedKeys > nodeCount) {
+            filterCapacity = expectedKeys;
+            filter.reset(filterCapacity);
+            fillFilter(root);
+            staleRemovals = 0;
+        } else {
+            refreshFilter();
+        }
+    }
+
+    // Desactiva el filtro y libera su memoria
+    void disableFilter() {
+        filterEnabled = false;
+        filter.blocks.clear();
+        filter.blocks.shrink_to_fit();
+        filterCapacity = 0;
+        staleRemovals = 0;
+    }
+
+    /**
+     * @brief Activa o desactiva el modo auto-ajustable.
+     * Útil cuando pocas llaves reciben la mayoría de consultas
+     * (distribución sesgada tipo Zipf): quedan cerca de la raíz.
+     */
+    void setSelfAdjusting(bool enabled) {
+        selfAdjusting = enabled;
     }
 
     // Inserta una llave y su respectivo dato [cite: 85]
     void insert(Key key, Value value) {
-        root = insertRecursive(root, key, value);
+        root = insertRecursive(root, key, value, NO_DEADLINE);
+        if (filterEnabled) {
+            filter.add(key);
+        }
+    }
+
+    /**
+     * @brief Inserta (llave, valor) que vence en el instante 'deadline'.
+     * Desde ese instante find()/contains() la tratan como ausente,
+     * y expire_until() la elimina de verdad.
+     */
+    void insert_until(Key key, Value value, Time deadline) {
+        root = insertRecursive(root, key, value, deadline);
+        if (filterEnabled) {
+            filter.add(key);
+        }
+        if (deadline != NO_DEADLINE) {
+            deadlines.push(Deadline(deadline, key));
+            compactDeadlines();
+        }
+    }
+
+    // Avanza el reloj usado para ocultar entradas vencidas (nunca retrocede)
+    void set_time(Time now) {
+        if (now > clockNow) {
+            clockNow = now;
+        }
+    }
+
+    /**
+     * @brief Elimina exactamente las entradas con vencimiento <= now.
+     * Saca del heap solo lo vencido: O(k log n) para k entradas.
+     * Retorna cuántas entradas se eliminaron.
+     */
+    int expire_until(Time now) {
+        set_time(now);
+        int expired = 0;
+        while (!deadlines.empty() && deadlines.top().first <= now) {
+            Deadline d = deadlines.top();
+            deadlines.pop();
+            Node* node = findNode(root, d.second);
+            // Si la llave cambió de vencimiento o ya no está, era una entrada vieja
+            if (node != nullptr && node->deadline == d.first) {
+                root = removeRecursive(root, d.second);
+                expired++;
+            }
+        }
+        return expired;
     }
 
     // Elimina de la estructura la llave y su elemento asociado [cite: 86]
@@ -188,26 +1097,494 @@ public:
      * o un valor por defecto si no se encuentra. [cite: 87]
      */
     Value find(Key key, Value defaultValue) {
-        Node* result = findNode(root, key);
+        if (filterRejects(key)) {
+            return defaultValue;
+        }
+        Node* result = lookup(key);
         if (result == nullptr) {
             return defaultValue;
         }
         return result->value;
     }
 
+    /**
+     * @brief Resumen de la política (p. ej. count, sum, min, max, countWhere)
+     * de todos los pares con llave en [lo, hi), en O(log n).
+     * Primero purga lo vencido según el reloj actual (como expire_until),
+     * así el resumen no cuenta entradas que find() ya trata como ausentes.
+     * Solo compila si el mapa tiene una política (TreapMap<StatsPolicy>).
+     */
+    Summary aggregate(Key lo, Key hi) {
+        static_assert(Augment::enabled, "aggregate() requiere una politica de aumento");
+        expire_until(clockNow);
+        clean(root);
+        return aggregateRecursive(root, lo, hi, true, true);
+    }
+
+    /**
+     * @brief Elimina todas las llaves en [lo, hi) en O(log n).
+     * Los 'delete' de los k nodos se hacen en segundo plano.
+     */
+    void erase_range(Key lo, Key hi) {
+        if (lo < hi) {
+            deferFree(cutRange(lo, hi));
+        }
+    }
+
+    // Retira las llaves en [lo, hi) y las retorna como un nuevo mapa
+    TreapMap extract_range(Key lo, Key hi) {
+        if (!(lo < hi)) {
+            return TreapMap();
+        }
+        return TreapMap(cutRange(lo, hi), clockNow, !deadlines.empty());
+    }
+
+    /**
+     * @brief Como find(), pero empieza desde el dedo en vez de la raíz
+     * y deja el dedo apuntando a la llave buscada.
+     */
+    Value find_from(Finger& finger, Key key, Value defaultValue) {
+        if (filterRejects(key)) {
+            return defaultValue;
+        }
+        Node* result = seek(finger, key);
+        if (result == nullptr || result->deadline <= clockNow) {
+            return defaultValue;
+        }
+        return result->value;
+    }
+
+    /**
+     * @brief Inserta usando el dedo como pista de dónde cae la llave.
+     * Busca desde el dedo (O(log d) comparaciones), cuelga la hoja y la
+     * sube rotando con el camino guardado, sin volver a la raíz.
+     * Los ancestros solo se marcan como sucios, y la marca se detiene en el
+     * primero que ya lo estaba: con llaves crecientes cuesta O(1) amortizado.
+     * Al final el dedo apunta al nodo insertado.
+     */
+    void insert(Finger& hint, Key key, Value value) {
+        if (filterEnabled) {
+            filter.add(key);
+        }
+        Node* existing = seek(hint, key);
+        vector<FingerStep>& path = hint.path;
+
+        if (existing != nullptr) {
+            existing->value = value;
+            existing->deadline = NO_DEADLINE;
+            markDirty(path, (int)path.size() - 1);
+            return;
+        }
+
+        Node* fresh = new Node(key, value, NO_DEADLINE);
+        nodeCount++;
+        if (path.empty()) {
+            root = fresh;
+        } else if (key < path.back().node->key) {
+            path.back().node->left = fresh;
+        } else {
+            path.back().node->right = fresh;
+        }
+
+        // Subir rotando mientras la prioridad del nodo nuevo sea mayor
+        int i = (int)path.size() - 1;
+        while (i >= 0 && fresh->priority > path[i].node->priority) {
+            Node* parent = path[i].node;
+            Node* top = parent->left == fresh ? rotateRight(parent) : rotateLeft(parent);
+            if (i == 0) {
+                root = top;
+            } else if (path[i - 1].node->left == parent) {
+                path[i - 1].node->left = top;
+            } else {
+                path[i - 1].node->right = top;
+            }
+            i--;
+        }
+        markDirty(path, i);
+
+        // Rearmar el dedo: los pasos 0..i siguen siendo ancestros válidos
+        path.resize(i + 1);
+        FingerStep step = {fresh, Key(), Key(), false, false};
+        if (i >= 0) {
+            step = path[i];
+            step.node = fresh;
+            if (key < path[i].node->key) {
+                step.hi = path[i].node->key;
+                step.hasHi = true;
+            } else {
+                step.lo = path[i].node->key;
+                step.hasLo = true;
+            }
+        }
+        path.push_back(step);
+        hint.version = shapeVersion;
+    }
+
     // Función extra (muy útil) para saber si una llave existe
     bool contains(Key key) {
-        return findNode(root, key) != nullptr;
+        if (filterRejects(key)) {
+            return false;
+        }
+        return lookup(key) != nullptr;
+    }
+
+    /**
+     * @brief Cuánta memoria ocupa el mapa, recorriendo todos los nodos: O(n).
+     * Con glibc el espacio real de cada bloque sale de malloc_usable_size();
+     * en otras plataformas se estima (cabecera de 8 bytes, múltiplos de 16).
+     */
+    MemoryUsage memory_usage() {
+        MemoryUsage usage = {0, 0, 0, 0, 0, 0, 0.0};
+        addMemory(root, usage);
+
+        size_t filterBytes = filter.blocks.capacity() * sizeof(BlockedBloomFilter::Block);
+        size_t heapBytes = deadlines.size() * sizeof(Deadline);
+        usage.auxiliaryBytes = filterBytes + heapBytes;
+        if (filterBytes > 0) {
+            usage.allocatorOverhead += blockOverhead(filter.blocks.data(), filterBytes);
+        }
+
+        usage.total = usage.nodeBytes + usage.valueHeapBytes
+                    + usage.auxiliaryBytes + usage.allocatorOverhead;
+        if (usage.total > 0) {
+            usage.fragmentation = (double)usage.allocatorOverhead / usage.total;
+        }
+        return usage;
+    }
+
+    /**
+     * @brief (Depuración) Imprime cuántos nodos hay en cada profundidad
+     * y la profundidad promedio; sirve para ver si el treap quedó balanceado.
+     */
+    void printDepthDistribution() {
+        vector<int> perDepth;
+        countDepths(root, 0, perDepth);
+        long long weighted = 0;
+        cout << "Profundidad -> nodos" << endl;
+        for (size_t d = 0; d < perDepth.size(); d++) {
+            cout << "  " << d << " -> " << perDepth[d] << endl;
+            weighted += (long long)d * perDepth[d];
+        }
+        if (nodeCount > 0) {
+            cout << "Profundidad promedio: " << (double)weighted / nodeCount << endl;
+        }
+    }
+
+private:
+    // Bytes extra que el malloc gasta en un bloque de 'requested' bytes
+    static size_t blockOverhead(const void* block, size_t requested) {
+#ifdef __GLIBC__
+        return malloc_usable_size(const_cast<void*>(block)) + sizeof(size_t) - requested;
+#else
+        (void)block;
+        size_t chunk = (requested + sizeof(size_t) + 15) / 16 * 16;
+        return chunk - requested;
+#endif
+    }
+
+    void addMemory(Node* node, MemoryUsage& usage) {
+        if (node == nullptr) {
+            return;
+        }
+        usage.nodes++;
+        usage.nodeBytes += sizeof(Node);
+        usage.allocatorOverhead += blockOverhead(node, sizeof(Node));
+
+        // Si la capacidad supera la del buffer interno (SSO), el texto vive aparte
+        static const size_t inlineCapacity = string().capacity();
+        size_t capacity = node->value.capacity();
+        if (capacity > inlineCapacity) {
+            usage.valueHeapBytes += capacity + 1;
+            usage.allocatorOverhead += blockOverhead(node->value.data(), capacity + 1);
+        }
+
+        addMemory(node->left, usage);
+        addMemory(node->right, usage);
+    }
+
+    void countDepths(Node* node, size_t depth, vector<int>& perDepth) {
+        if (node == nullptr) {
+            return;
+        }
+        if (perDepth.size() <= depth) {
+            perDepth.resize(depth + 1, 0);
+        }
+        perDepth[depth]++;
+        countDepths(node->left, depth + 1, perDepth);
+        countDepths(node->right, depth + 1, perDepth);
+    }
+};
+
+// ======================================================
+// Grabar y repetir trazas de operaciones
+// ======================================================
+
+// Operaciones que se graban (1 byte cada una en el archivo)
+enum TraceOp {
+    TRACE_INSERT = 0,
+    TRACE_REMOVE = 1,
+    TRACE_FIND = 2,
+    TRACE_CONTAINS = 3
+};
+
+/**
+ * @brief Escribe una traza binaria compacta. Cada registro es:
+ * [op: 1 byte][llave: varint zigzag][solo insert: largo varint + bytes].
+ * Las llaves cercanas a 0 (o negativas pequeñas) ocupan 1 o 2 bytes.
+ */
+class TraceRecorder {
+private:
+    ofstream out;
+
+    void writeVarint(uint64_t x) {
+        while (x >= 0x80) {
+            out.put((char)(x | 0x80));
+            x >>= 7;
+        }
+        out.put((char)x);
+    }
+
+public:
+    explicit TraceRecorder(const string& path) : out(path.c_str(), ios::binary) {
+        out.write("TRPL", 4); // Firma del formato
+    }
+
+    bool ok() {
+        return (bool)out;
+    }
+
+    void record(TraceOp op, Key key, const Value* value = nullptr) {
+        out.put((char)op);
+        int64_t k = key;
+        writeVarint(((uint64_t)k << 1) ^ (uint64_t)(k >> 63)); // zigzag
+        if (value != nullptr) {
+            writeVarint(value->size());
+            out.write(value->data(), value->size());
+        }
+    }
+};
+
+/**
+ * @brief Capa de trazado: se usa igual que un TreapMap, pero además
+ * graba cada insert/remove/find/contains en un TraceRecorder.
+ */
+template <class Augment = NoAugment>
+class TracedTreapMap {
+private:
+    TreapMap<Augment>& map;
+    TraceRecorder& recorder;
+
+public:
+    TracedTreapMap(TreapMap<Augment>& m, TraceRecorder& r) : map(m), recorder(r) {}
+
+    void insert(Key key, Value value) {
+        recorder.record(TRACE_INSERT, key, &value);
+        map.insert(key, value);
+    }
+
+    void remove(Key key) {
+        recorder.record(TRACE_REMOVE, key);
+        map.remove(key);
+    }
+
+    Value find(Key key, Value defaultValue) {
+        recorder.record(TRACE_FIND, key);
+        return map.find(key, defaultValue);
+    }
+
+    bool contains(Key key) {
+        recorder.record(TRACE_CONTAINS, key);
+        return map.contains(key);
+    }
+};
+
+// Un registro ya decodificado de la traza
+struct TraceEntry {
+    TraceOp op;
+    Key key;
+    Value value;
+};
+
+/**
+ * @brief Lee una traza completa a memoria (así la lectura del
+ * archivo no se mezcla con lo que se mide). Retorna false si el
+ * archivo no existe o no tiene el formato esperado (incluido un largo
+ * de valor mayor que lo que queda del archivo).
+ */
+bool loadTrace(const string& path, vector<TraceEntry>& entries) {
+    ifstream in(path.c_str(), ios::binary);
+    char magic[4];
+    if (!in.read(magic, 4) || string(magic, 4) != "TRPL") {
+        return false;
+    }
+    in.seekg(0, ios::end);
+    uint64_t fileSize = (uint64_t)in.tellg();
+    in.seekg(4, ios::beg);
+    struct Reader {
+        static bool varint(ifstream& in, uint64_t& x) {
+            x = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                int c = in.get();
+                if (c == EOF) return false;
+                x |= (uint64_t)(c & 0x7F) << shift;
+                if ((c & 0x80) == 0) return true;
+            }
+            return false;
+        }
+    };
+    int op;
+    while ((op = in.get()) != EOF) {
+        TraceEntry e;
+        uint64_t z;
+        if (op > TRACE_CONTAINS || !Reader::varint(in, z)) {
+            return false;
+        }
+        e.op = (TraceOp)op;
+        e.key = (Key)(int64_t)((z >> 1) ^ (~(z & 1) + 1)); // des-zigzag
+        if (e.op == TRACE_INSERT) {
+            uint64_t length;
+            if (!Reader::varint(in, length)) return false;
+            if (length > fileSize - (uint64_t)in.tellg()) return false; // Truncado o corrupto
+            e.value.resize(length);
+            if (length > 0 && !in.read(&e.value[0], length)) return false;
+        }
+        entries.push_back(e);
+    }
+    return true;
+}
+
+/**
+ * @brief Contadores de hardware del proceso (Linux, perf_event_open).
+ * Si el sistema no los permite, 'available' queda en false y todo
+ * lo demás sigue funcionando.
+ */
+class PerfCounters {
+private:
+    int fds[2]; // ciclos, instrucciones
+
+public:
+    bool available;
+    long long cycles, instructions;
+
+    PerfCounters() {
+        available = false;
+        cycles = 0;
+        instructions = 0;
+        fds[0] = fds[1] = -1;
+#ifdef __linux__
+        const unsigned long long configs[2] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS};
+        for (int i = 0; i < 2; i++) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+        available = fds[0] >= 0 && fds[1] >= 0;
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int i = 0; i < 2; i++) {
+            if (fds[i] >= 0) close(fds[i]);
+        }
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (!available) return;
+        for (int i = 0; i < 2; i++) {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        if (!available) return;
+        long long values[2] = {0, 0};
+        for (int i = 0; i < 2; i++) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &values[i], sizeof(long long)) != (ssize_t)sizeof(long long)) {
+                available = false;
+            }
+        }
+        cycles = values[0];
+        instructions = values[1];
+#endif
     }
 };
 
+// Resultado de repetir una traza
+struct ReplayReport {
+    int operations;
+    int hits;          // find/contains que encontraron la llave
+    double seconds;
+    bool hasCounters;  // false si no hubo contadores de hardware
+    long long cycles, instructions;
+};
+
+/**
+ * @brief Repite una traza contra cualquier mapa con la interfaz de
+ * TreapMap (insert, remove, find, contains): TreapMap<>, TreapMap<StatsPolicy>,
+ * con o sin filtro, auto-ajustable, etc.
+ * Mide el tiempo total y, si se puede, ciclos e instrucciones.
+ * Los FIND se repiten con find(), copia del Value incluida, igual que
+ * en la carga grabada; cuentan como acierto si no devuelven el centinela
+ * 'missing' (un valor que ninguna traza normal guarda).
+ */
+template <class MapType>
+ReplayReport replay(const vector<TraceEntry>& entries, MapType& map) {
+    ReplayReport report = {0, 0, 0.0, false, 0, 0};
+    const Value missing("\x01<sin llave>");
+    PerfCounters counters;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    counters.start();
+    for (size_t i = 0; i < entries.size(); i++) {
+        const TraceEntry& e = entries[i];
+        switch (e.op) {
+            case TRACE_INSERT:   map.insert(e.key, e.value); break;
+            case TRACE_REMOVE:   map.remove(e.key); break;
+            case TRACE_FIND:     if (map.find(e.key, missing) != missing) report.hits++; break;
+            case TRACE_CONTAINS: if (map.contains(e.key)) report.hits++; break;
+        }
+    }
+    counters.stop();
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    report.operations = (int)entries.size();
+    report.seconds = chrono::duration<double>(end - begin).count();
+    report.hasCounters = counters.available;
+    report.cycles = counters.cycles;
+    report.instructions = counters.instructions;
+    return report;
+}
+
+void printReport(const ReplayReport& r) {
+    cout << "  " << r.operations << " operaciones, " << r.hits << " aciertos, "
+         << r.seconds * 1e9 / (r.operations > 0 ? r.operations : 1) << " ns/op";
+    if (r.hasCounters) {
+        cout << ", " << (double)r.cycles / r.operations << " ciclos/op, IPC "
+             << (r.cycles > 0 ? (double)r.instructions / r.cycles : 0.0);
+    } else {
+        cout << " (sin contadores de hardware)";
+    }
+    cout << endl;
+}
+
 // --- Ejemplo de Uso ---
 int main() {
     // Inicializar la semilla aleatoria
     srand(time(NULL));
 
     cout << "--- Ejemplo de TreapMap (int -> string) ---" << endl;
-    TreapMap miMapa;
+    TreapMap<StatsPolicy> miMapa;
 
     // insert
     miMapa.insert(50, "Alejandro");
@@ -230,5 +1607,101 @@ int main() {
     cout << "remove(70)..." << endl;
     cout << "contains(70)? " << (miMapa.contains(70) ? "Si" : "No") << endl;
 
+    // Filtro de Bloom: las búsquedas fallidas no recorren el árbol
+    miMapa.enableFilter(1000);
+    for (int i = 0; i < 1000; i++) {
+        miMapa.insert(i * 2, "par");
+    }
+    int fallidas = 0;
+    for (int i = 0; i < 1000; i++) {
+        if (!miMapa.contains(i * 2 + 1)) fallidas++;
+    }
+    cout << "Filtro activo, busquedas de impares ausentes: " << fallidas << " de 1000" << endl;
+    cout << "find(1998, 'N/A'): " << miMapa.find(1998, "N/A") << endl;
+
+    // Modo auto-ajustable: la llave más consultada sube hacia la raíz
+    miMapa.setSelfAdjusting(true);
+    for (int i = 0; i < 50; i++) {
+        miMapa.find(1000, "N/A");
+    }
+    cout << "Tras 50 consultas, find(1000, 'N/A'): " << miMapa.find(1000, "N/A") << endl;
+
+    // Resumen de rango: métrica = longitud del valor
+    miMapa.insert(11, "Diego");
+    StatsPolicy::Summary resumen = miMapa.aggregate(0, 20);
+    cout << "aggregate[0, 20): count=" << resumen.count << " sum=" << resumen.sum
+         << " min=" << resumen.min << " max=" << resumen.max
+         << " countWhere=" << resumen.countWhere << endl;
+
+    // Operaciones por rango: dos splits y un join
+    TreapMap<StatsPolicy> extraido = miMapa.extract_range(100, 200);
+    cout << "extract_range(100, 200) -> size(): " << extraido.size()
+         << ", quedan: " << miMapa.size() << endl;
+    miMapa.erase_range(1000, 1500);
+    cout << "erase_range(1000, 1500) -> contains(1200)? "
+         << (miMapa.contains(1200) ? "Si" : "No") << ", size(): " << miMapa.size() << endl;
+
+    // Dedo: inserciones casi ordenadas empiezan cerca de la anterior
+    TreapMap<> serie;
+    TreapMap<>::Finger dedo;
+    for (int i = 0; i < 1000; i++) {
+        serie.insert(dedo, i, "t");
+    }
+    cout << "Serie con dedo -> size(): " << serie.size()
+         << ", find_from(dedo, 998): " << serie.find_from(dedo, 998, "N/A") << endl;
+
+    // Liberación en segundo plano: clear() retorna sin hacer los 'delete'
+    serie.setAsyncTeardown(true);
+    serie.clear();
+    TreapMap<>::waitForTeardown();
+    cout << "clear() asincrono -> size(): " << serie.size() << endl;
+
+    // Memoria: nodos, texto fuera del objeto y desperdicio del malloc
+    MemoryUsage memoria = miMapa.memory_usage();
+    cout << "memory_usage(): " << memoria.nodes << " nodos, " << memoria.nodeBytes
+         << " B en nodos, " << memoria.valueHeapBytes << " B en valores, "
+         << memoria.auxiliaryBytes << " B auxiliares, " << memoria.allocatorOverhead
+         << " B de overhead (fragmentacion " << memoria.fragmentation * 100 << "%)" << endl;
+    cout << "sizeof(nodo): " << sizeof(TreapNode<NoAugment>) << " B sin politica, "
+         << sizeof(TreapNode<StatsPolicy>) << " B con StatsPolicy" << endl;
+
+    // Vencimientos: la sesión 7 vence en t=100 y la 8 en t=200
+    TreapMap<> cache;
+    cache.insert_until(7, "sesion-7", 100);
+    cache.insert_until(8, "sesion-8", 200);
+    cache.set_time(150);
+    cout << "t=150 -> contains(7)? " << (cache.contains(7) ? "Si" : "No")
+         << ", contains(8)? " << (cache.contains(8) ? "Si" : "No") << endl;
+    cout << "expire_until(150) elimino: " << cache.expire_until(150)
+         << ", size(): " << cache.size() << endl;
+
+    // Grabar una carga de trabajo y repetirla después
+    {
+        TreapMap<> produccion;
+        TraceRecorder grabador("traza_treapmap.bin");
+        TracedTreapMap<> trazado(produccion, grabador);
+        for (int i = 0; i < 20000; i++) {
+            int llave = rand() % 5000;
+            if (i % 4 == 0) trazado.insert(llave, "dato");
+            else if (i % 17 == 0) trazado.remove(llave);
+            else if (i % 2 == 0) trazado.find(llave, "");
+            else trazado.contains(llave);
+        }
+    }
+    vector<TraceEntry> traza;
+    if (loadTrace("traza_treapmap.bin", traza)) {
+        TreapMap<> normal;
+        TreapMap<> conFiltro;
+        TreapMap<StatsPolicy> conResumen;
+        conFiltro.enableFilter(5000);
+        cout << "replay(TreapMap<>):" << endl;
+        printReport(replay(traza, normal));
+        cout << "replay(TreapMap<> + filtro):" << endl;
+        printReport(replay(traza, conFiltro));
+        cout << "replay(TreapMap<StatsPolicy>):" << endl;
+        printReport(replay(traza, conResumen));
+    }
+    std::remove("traza_treapmap.bin");
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <iostream>
+#include <cstdlib>   // Para rand() y srand()
+#include <ctime>     // Para time()
+#include <stdexcept> // Para out_of_range
+
+using namespace std;
+
+/**
+ * @brief Nodo para el TreapMultiset.
+ * Un nodo por llave distinta: los repetidos solo aumentan 'count'.
+ */
+struct Node {
+    int key;        // El elemento (llave del BST)
+    int count;      // Multiplicidad de la llave
+    int total;      // Suma de 'count' en todo el subárbol
+    int priority;   // Prioridad aleatoria (valor del MaxHeap)
+    Node *left, *right;
+
+    // Constructor: asigna la llave, su multiplicidad y una prioridad aleatoria
+    Node(int k, int n) {
+        key = k;
+        count = n;
+        total = n;
+        priority = rand();
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/**
+ * @brief Implementa una Bolsa (Multiset) usando un Treap.
+ * A diferencia de TreapSet, sí admite repetidos, guardando un contador
+ * por nodo. Un flujo con muchos duplicados cuesta un nodo por llave distinta.
+ */
+class TreapMultiset {
+private:
+    Node* root;         // Raíz del árbol
+    int distinctCount;  // Cantidad de llaves distintas (nodos)
+
+    static int totalOf(Node* node) {
+        return node == nullptr ? 0 : node->total;
+    }
+
+    // Recalcula 'total' a partir de los hijos
+    static void update(Node* node) {
+        node->total = totalOf(node->left) + node->count + totalOf(node->right);
+    }
+
+    // --- Funciones de Rotación ---
+    // Idénticas a las de TreapSet, pero mantienen 'total':
+    // primero el nodo que baja y luego el que sube.
+
+    Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        update(y);
+        update(x);
+        return x;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        update(x);
+        update(y);
+        return y;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Ayudante recursivo para insertar 'n' copias de 'key'.
+     * Si la llave ya existe, solo suma a su contador.
+     */
+    Node* insertRecursive(Node* node, int key, int n) {
+        if (node == nullptr) {
+            distinctCount++;
+            return new Node(key, n);
+        }
+
+        if (key < node->key) {
+            node->left = insertRecursive(node->left, key, n);
+            if (node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (key > node->key) {
+            node->right = insertRecursive(node->right, key, n);
+            if (node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        } else {
+            node->count += n;
+        }
+
+        update(node);
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para quitar UNA copia de 'key'.
+     * Solo cuando el contador llega a 0 se elimina el nodo
+     * (con la misma rotación hacia abajo de TreapSet).
+     * 'removed' indica si la llave existía.
+     */
+    Node* eraseOneRecursive(Node* node, int key, bool& removed) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (key < node->key) {
+            node->left = eraseOneRecursive(node->left, key, removed);
+        } else if (key > node->key) {
+            node->right = eraseOneRecursive(node->right, key, removed);
+        } else {
+            if (!removed) {
+                removed = true;
+                node->count--;
+            }
+            if (node->count > 0) {
+                update(node);
+                return node;
+            }
+
+            // Contador en 0: eliminar el nodo
+            if (node->left == nullptr) {
+                Node* temp = node->right;
+                delete node;
+                distinctCount--;
+                return temp;
+            } else if (node->right == nullptr) {
+                Node* temp = node->left;
+                delete node;
+                distinctCount--;
+                return temp;
+            }
+
+            // 2 hijos: rotar hacia el hijo de mayor prioridad
+            if (node->left->priority > node->right->priority) {
+                node = rotateRight(node);
+                node->right = eraseOneRecursive(node->right, key, removed);
+            } else {
+                node = rotateLeft(node);
+                node->left = eraseOneRecursive(node->left, key, removed);
+            }
+        }
+        update(node);
+        return node;
+    }
+
+    // Libera toda la memoria del árbol
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de una bolsa vacía
+    TreapMultiset() {
+        root = nullptr;
+        distinctCount = 0;
+    }
+
+    // Destructor
+    ~TreapMultiset() {
+        clear();
+    }
+
+    // Vacía la bolsa
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        distinctCount = 0;
+    }
+
+    // Cantidad total de elementos (contando repetidos)
+    int size() {
+        return totalOf(root);
+    }
+
+    // Cantidad de llaves distintas (= cantidad de nodos)
+    int distinct() {
+        return distinctCount;
+    }
+
+    // Adiciona 'n' copias de 'key' (por defecto una)
+    void insert(int key, int n = 1) {
+        if (n > 0) {
+            root = insertRecursive(root, key, n);
+        }
+    }
+
+    // Retira una copia de 'key'. Retorna false si no había ninguna.
+    bool erase_one(int key) {
+        bool removed = false;
+        root = eraseOneRecursive(root, key, removed);
+        return removed;
+    }
+
+    // Multiplicidad de 'key' (0 si no está)
+    int count(int key) {
+        Node* node = root;
+        while (node != nullptr) {
+            if (key == node->key) {
+                return node->count;
+            }
+            node = key < node->key ? node->left : node->right;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Cantidad de elementos estrictamente menores que 'key',
+     * contando repetidos. O(log n).
+     */
+    int rank(int key) {
+        int result = 0;
+        Node* node = root;
+        while (node != nullptr) {
+            if (key <= node->key) {
+                node = node->left;
+            } else {
+                result += totalOf(node->left) + node->count;
+                node = node->right;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief El k-ésimo elemento en orden (k empieza en 0), contando
+     * repetidos. Ej: en {5, 5, 7}, select(1) = 5 y select(2) = 7. O(log n).
+     */
+    int select(int k) {
+        if (k < 0 || k >= size()) {
+            throw out_of_range("select: indice fuera de rango.");
+        }
+        Node* node = root;
+        while (true) {
+            int leftTotal = totalOf(node->left);
+            if (k < leftTotal) {
+                node = node->left;
+            } else if (k < leftTotal + node->count) {
+                return node->key;
+            } else {
+                k -= leftTotal + node->count;
+                node = node->right;
+            }
+        }
+    }
+};
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de TreapMultiset (Bolsa de ints) ---" << endl;
+    TreapMultiset bolsa;
+
+    // insert
+    bolsa.insert(50);
+    bolsa.insert(30, 3);
+    bolsa.insert(70);
+    bolsa.insert(50);
+
+    cout << "Insertando 50, 30 (x3), 70, 50..." << endl;
+    cout << "size(): " << bolsa.size() << "  distinct(): " << bolsa.distinct() << endl;
+
+    // count
+    cout << "count(30): " << bolsa.count(30) << endl;
+    cout << "count(99): " << bolsa.count(99) << endl;
+
+    // rank / select
+    cout << "rank(50): " << bolsa.rank(50) << endl;
+    cout << "select(3): " << bolsa.select(3) << endl;
+
+    // erase_one
+    bolsa.erase_one(30);
+    cout << "erase_one(30)..." << endl;
+    cout << "count(30): " << bolsa.count(30) << "  size(): " << bolsa.size() << endl;
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+#include <iostream>
+#include <string>    // Para usar std::string
+#include <cstdlib>   // Para rand() y srand()
+#include <ctime>     // Para time()
+#include <stdexcept> // Para out_of_range
+#include <atomic>    // Para el contador global de ids
+
+using namespace std;
+
+typedef string Value;
+
+/**
+ * @brief Nodo para el TreapPQ.
+ * Aquí los papeles del Treap se invierten:
+ * - 'priority' la da el usuario y ordena el MaxHeap.
+ * - 'key' es aleatoria y solo sirve para que el BST quede balanceado.
+ */
+struct Node {
+    Value value;
+    int priority;        // Prioridad del usuario (MaxHeap)
+    int key;             // Llave aleatoria (BST)
+    unsigned long id;    // Desempate único entre llaves aleatorias iguales
+    Node *left, *right;
+
+    // Constructor: asigna valor, prioridad y una llave aleatoria
+    Node(Value v, int p, unsigned long uniqueId) {
+        value = v;
+        priority = p;
+        key = rand();
+        id = uniqueId;
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/**
+ * @brief Cola de prioridad "fusionable" construida sobre un Treap.
+ * push, pop_max y decrease_key cuestan O(log n) esperado, y meld
+ * une dos colas sin reconstruirlas (algo que std::priority_queue no permite).
+ */
+class TreapPQ {
+public:
+    // Un handle apunta al nodo de un elemento; sigue siendo válido
+    // tras meld(), y deja de serlo cuando el elemento sale con pop_max().
+    typedef Node* Handle;
+
+private:
+    Node* root;     // Raíz del árbol (el de mayor prioridad)
+    int nodeCount;  // Cantidad de elementos
+
+    // Contador global: las llaves deben ser únicas entre colas para meld().
+    // Es atómico porque cada hilo puede tener su propia cola y hacer push a la vez.
+    static atomic<unsigned long> nextId;
+
+    // Orden del BST: llave aleatoria y, si empatan, el id
+    static bool less(Node* a, Node* b) {
+        return a->key < b->key || (a->key == b->key && a->id < b->id);
+    }
+
+    // --- Funciones de Rotación ---
+    // Idénticas a las de TreapSet.
+
+    Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        return x;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        return y;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Inserta un nodo ya creado: baja por su llave aleatoria
+     * y rota hacia arriba mientras su prioridad sea mayor.
+     */
+    Node* insertRecursive(Node* node, Node* fresh) {
+        if (node == nullptr) {
+            return fresh;
+        }
+        if (less(fresh, node)) {
+            node->left = insertRecursive(node->left, fresh);
+            if (node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else {
+            node->right = insertRecursive(node->right, fresh);
+            if (node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        }
+        return node;
+    }
+
+    /**
+     * @brief Une dos treaps donde todas las llaves de 'left' son menores
+     * que las de 'right'. Sube la raíz de mayor prioridad.
+     */
+    Node* join(Node* left, Node* right) {
+        if (left == nullptr) return right;
+        if (right == nullptr) return left;
+        if (left->priority > right->priority) {
+            left->right = join(left->right, right);
+            return left;
+        } else {
+            right->left = join(left, right->left);
+            return right;
+        }
+    }
+
+    // Parte el subárbol en llaves menores y mayores que las de 'pivot'
+    void split(Node* node, Node* pivot, Node*& left, Node*& right) {
+        if (node == nullptr) {
+            left = nullptr;
+            right = nullptr;
+            return;
+        }
+        if (less(node, pivot)) {
+            split(node->right, pivot, node->right, right);
+            left = node;
+        } else {
+            split(node->left, pivot, left, node->left);
+            right = node;
+        }
+    }
+
+    /**
+     * @brief Unión de dos treaps con llaves intercaladas.
+     * La raíz de mayor prioridad se queda arriba; el otro árbol se parte
+     * por su llave y cada mitad se une recursivamente a un lado.
+     * Cuesta O(m log(n/m)) esperado, con m <= n los tamaños.
+     */
+    Node* unionRecursive(Node* a, Node* b) {
+        if (a == nullptr) return b;
+        if (b == nullptr) return a;
+        if (a->priority < b->priority) {
+            Node* temp = a;
+            a = b;
+            b = temp;
+        }
+        Node *lower, *upper;
+        split(b, a, lower, upper);
+        a->left = unionRecursive(a->left, lower);
+        a->right = unionRecursive(a->right, upper);
+        return a;
+    }
+
+    /**
+     * @brief Desengancha 'target' del árbol sin liberarlo.
+     * Se encuentra bajando por su llave aleatoria (como en un BST),
+     * y sus hijos se unen con join() para ocupar su lugar.
+     * Si se llega a un nullptr, el nodo no es de esta cola (el árbol no cambia).
+     */
+    Node* detachRecursive(Node* node, Node* target) {
+        if (node == nullptr) {
+            throw invalid_argument("decrease_key: el handle no pertenece a esta cola.");
+        }
+        if (node == target) {
+            Node* merged = join(node->left, node->right);
+            target->left = nullptr;
+            target->right = nullptr;
+            return merged;
+        }
+        if (less(target, node)) {
+            node->left = detachRecursive(node->left, target);
+        } else {
+            node->right = detachRecursive(node->right, target);
+        }
+        return node;
+    }
+
+    // Libera toda la memoria del árbol
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de una cola vacía
+    TreapPQ() {
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Destructor
+    ~TreapPQ() {
+        clear();
+    }
+
+    // Vacía la cola
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    int size() {
+        return nodeCount;
+    }
+
+    bool empty() {
+        return root == nullptr;
+    }
+
+    // Adiciona un elemento con la prioridad dada y retorna su handle
+    Handle push(Value value, int priority) {
+        Node* fresh = new Node(value, priority, nextId.fetch_add(1));
+        root = insertRecursive(root, fresh);
+        nodeCount++;
+        return fresh;
+    }
+
+    // Elemento de mayor prioridad (la raíz)
+    Value top() {
+        if (root == nullptr) {
+            throw out_of_range("top: la cola esta vacia.");
+        }
+        return root->value;
+    }
+
+    int top_priority() {
+        if (root == nullptr) {
+            throw out_of_range("top_priority: la cola esta vacia.");
+        }
+        return root->priority;
+    }
+
+    // Retira y retorna el elemento de mayor prioridad
+    Value pop_max() {
+        if (root == nullptr) {
+            throw out_of_range("pop_max: la cola esta vacia.");
+        }
+        Node* old = root;
+        Value result = old->value;
+        root = join(old->left, old->right);
+        delete old;
+        nodeCount--;
+        return result;
+    }
+
+    /**
+     * @brief Cambia la prioridad del elemento 'handle'.
+     * Se desengancha el nodo y se vuelve a insertar: O(log n).
+     * (Sirve igual si la nueva prioridad es mayor.)
+     * Un handle de otra cola lanza invalid_argument; uno que ya salió con
+     * pop_max() apunta a memoria liberada y no se puede detectar.
+     */
+    void decrease_key(Handle handle, int newPriority) {
+        if (handle == nullptr) {
+            throw invalid_argument("decrease_key: handle nulo.");
+        }
+        root = detachRecursive(root, handle);
+        handle->priority = newPriority;
+        root = insertRecursive(root, handle);
+    }
+
+    /**
+     * @brief Mueve todos los elementos de 'other' a esta cola.
+     * 'other' queda vacía y sus handles siguen sirviendo aquí.
+     */
+    void meld(TreapPQ& other) {
+        if (&other == this) return;
+        root = unionRecursive(root, other.root);
+        nodeCount += other.nodeCount;
+        other.root = nullptr;
+        other.nodeCount = 0;
+    }
+};
+
+atomic<unsigned long> TreapPQ::nextId(0);
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de TreapPQ (tareas por prioridad) ---" << endl;
+    TreapPQ trabajador1, trabajador2;
+
+    // push
+    trabajador1.push("compilar", 5);
+    TreapPQ::Handle h = trabajador1.push("indexar", 9);
+    trabajador1.push("limpiar", 1);
+    trabajador2.push("respaldar", 7);
+    trabajador2.push("notificar", 3);
+
+    cout << "top() del trabajador 1: " << trabajador1.top() << endl;
+
+    // decrease_key
+    trabajador1.decrease_key(h, 2);
+    cout << "decrease_key(indexar, 2)..." << endl;
+    cout << "top() del trabajador 1: " << trabajador1.top() << endl;
+
+    // meld
+    trabajador1.meld(trabajador2);
+    cout << "meld(trabajador 2) -> size(): " << trabajador1.size() << endl;
+
+    // pop_max
+    cout << "Orden de salida: ";
+    while (!trabajador1.empty()) {
+        cout << trabajador1.pop_max() << " ";
+    }
+    cout << endl;
+
+    return 0;
+}
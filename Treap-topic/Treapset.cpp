@@ -1,27 +1,106 @@
 #include <iostream>
 #include <cstdlib> // Para rand() y srand()
 #include <ctime>   // Para time()
+#include <thread>  // Para liberar memoria en segundo plano
+#include <mutex>   // Para la cola del hilo liberador
+#include <condition_variable>
+#include <vector>
 
 using namespace std;
 
 /**
  * @brief Nodo para el TreapSet.
- * Almacena el elemento (llave) y su prioridad aleatoria.
+ * Almacena el elemento (llave), su prioridad aleatoria y el tamaño
+ * de su subárbol (para saber cuántas llaves tiene un rango sin contarlas).
  */
 struct Node {
     int key;          // El elemento (llave del BST)
     int priority;   // Prioridad aleatoria (valor del MaxHeap)
+    int size;         // Nodos del subárbol que cuelga de este nodo
     Node *left, *right;
 
     // Constructor: asigna la llave y una prioridad aleatoria
     Node(int k) {
         key = k;
         priority = rand(); // Prioridad aleatoria
+        size = 1;
         left = nullptr;
         right = nullptr;
     }
 };
 
+/**
+ * @brief Hilo liberador compartido por todo el programa.
+ * submit() encola una raíz y retorna de inmediato; un único hilo (que
+ * vive lo mismo que el proceso) hace los 'delete'. Nadie espera a otro
+ * submit() anterior, y ningún destructor hace join.
+ */
+class NodeReclaimer {
+private:
+    mutex lock;
+    condition_variable wake;  // Hay trabajo
+    condition_variable idle;  // No queda trabajo (para drain)
+    vector<Node*> pending;
+    bool busy;
+    thread worker;
+
+    NodeReclaimer() {
+        busy = false;
+    }
+
+    static void freeSerial(Node* node) {
+        if (node != nullptr) {
+            freeSerial(node->left);
+            freeSerial(node->right);
+            delete node;
+        }
+    }
+
+    void run() {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [this] { return !pending.empty(); });
+            vector<Node*> batch;
+            batch.swap(pending);
+            busy = true;
+            guard.unlock();
+            for (size_t i = 0; i < batch.size(); i++) {
+                freeSerial(batch[i]);
+            }
+            guard.lock();
+            busy = false;
+            idle.notify_all();
+        }
+    }
+
+public:
+    // Instancia única; nunca se destruye, así que su hilo no se espera al salir
+    static NodeReclaimer& shared() {
+        static NodeReclaimer* instance = new NodeReclaimer();
+        return *instance;
+    }
+
+    void submit(Node* node) {
+        if (node == nullptr) {
+            return;
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            pending.push_back(node);
+            if (!worker.joinable()) {
+                worker = thread(&NodeReclaimer::run, this);
+            }
+        }
+        wake.notify_one();
+    }
+
+    // Espera a que todo lo entregado se haya liberado
+    void drain() {
+        unique_lock<mutex> guard(lock);
+        idle.wait(guard, [this] { return pending.empty() && !busy; });
+    }
+};
+
 /**
  * @brief Implementa el concepto de Conjunto (Set) usando un Treap.
  * [cite: 73]
@@ -32,6 +111,15 @@ private:
     Node* root;      // Raíz del árbol
     int nodeCount;   // Contador para la cardinalidad [cite: 76]
 
+    static int sizeOf(Node* node) {
+        return node == nullptr ? 0 : node->size;
+    }
+
+    // Recalcula el tamaño del subárbol a partir de los hijos
+    static void update(Node* node) {
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+    }
+
     // --- Funciones de Rotación ---
     // Se usan para mantener la propiedad de MaxHeap.
 
@@ -52,6 +140,8 @@ private:
         // Realizar rotación
         x->right = y;
         y->left = T2;
+        update(y); // Primero el que bajó, luego el que subió
+        update(x);
 
         return x; // 'x' es la nueva raíz del subárbol
     }
@@ -73,6 +163,8 @@ private:
         // Realizar rotación
         y->left = x;
         x->right = T2;
+        update(x);
+        update(y);
 
         return y; // 'y' es la nueva raíz del subárbol
     }
@@ -107,6 +199,7 @@ private:
         }
         // Si key == node->key, no hacemos nada (es un conjunto).
 
+        update(node);
         return node;
     }
 
@@ -156,6 +249,7 @@ private:
                 node->left = removeRecursive(node->left, key);
             }
         }
+        update(node);
         return node;
     }
 
@@ -177,8 +271,59 @@ private:
         }
     }
 
+    /**
+     * @brief Parte el subárbol en dos treaps:
+     * 'left' con las llaves < key y 'right' con las llaves >= key.
+     * Solo recorre un camino: O(log n).
+     */
+    void split(Node* node, int key, Node*& left, Node*& right) {
+        if (node == nullptr) {
+            left = nullptr;
+            right = nullptr;
+            return;
+        }
+        if (node->key < key) {
+            split(node->right, key, node->right, right);
+            left = node;
+        } else {
+            split(node->left, key, left, node->left);
+            right = node;
+        }
+        update(node);
+    }
+
+    /**
+     * @brief Une dos treaps donde todas las llaves de 'left' son menores
+     * que las de 'right'. Sube la raíz de mayor prioridad. O(log n).
+     */
+    Node* join(Node* left, Node* right) {
+        if (left == nullptr) return right;
+        if (right == nullptr) return left;
+        if (left->priority > right->priority) {
+            left->right = join(left->right, right);
+            update(left);
+            return left;
+        } else {
+            right->left = join(left, right->left);
+            update(right);
+            return right;
+        }
+    }
+
+    /**
+     * @brief Separa del árbol las llaves en [lo, hi) con dos splits
+     * y un join. Retorna la raíz del subárbol separado.
+     */
+    Node* cutRange(int lo, int hi) {
+        Node *before, *rest, *middle, *after;
+        split(root, lo, before, rest);
+        split(rest, hi, middle, after);
+        root = join(before, after);
+        return middle;
+    }
+
     // Libera toda la memoria del árbol
-    void clearRecursive(Node* node) {
+    static void clearRecursive(Node* node) {
         if (node != nullptr) {
             clearRecursive(node->left);
             clearRecursive(node->right);
@@ -186,6 +331,20 @@ private:
         }
     }
 
+    /**
+     * @brief Libera un subárbol en el hilo liberador compartido, para que
+     * quien llamó no pague el costo de los 'delete'. Retorna de inmediato.
+     */
+    void deferFree(Node* subtree) {
+        NodeReclaimer::shared().submit(subtree);
+    }
+
+    // Constructor privado: envuelve un subárbol ya armado
+    explicit TreapSet(Node* subtree) {
+        root = subtree;
+        nodeCount = sizeOf(subtree);
+    }
+
 public:
     // Constructor de un conjunto vacío [cite: 75]
     TreapSet() {
@@ -193,6 +352,14 @@ public:
         nodeCount = 0;
     }
 
+    // Constructor de movimiento: se adueña del árbol de 'other'
+    TreapSet(TreapSet&& other) {
+        root = other.root;
+        nodeCount = other.nodeCount;
+        other.root = nullptr;
+        other.nodeCount = 0;
+    }
+
     // Destructor [cite: 75]
     ~TreapSet() {
         clear();
@@ -231,6 +398,33 @@ public:
     bool member(int key) {
         return memberRecursive(root, key);
     }
+
+    /**
+     * @brief Retira todas las llaves en [lo, hi) en O(log n): el tamaño
+     * del rango sale del nodo raíz del subárbol separado, y los 'delete'
+     * de sus k llaves se hacen en segundo plano.
+     */
+    void erase_range(int lo, int hi) {
+        if (!(lo < hi)) return;
+        Node* middle = cutRange(lo, hi);
+        nodeCount -= sizeOf(middle);
+        deferFree(middle);
+    }
+
+    // Espera a que el hilo liberador termine lo pendiente (útil en pruebas)
+    static void waitForReclaimer() {
+        NodeReclaimer::shared().drain();
+    }
+
+    // Retira las llaves en [lo, hi) y las retorna como un nuevo conjunto
+    TreapSet extract_range(int lo, int hi) {
+        Node* middle = nullptr;
+        if (lo < hi) {
+            middle = cutRange(lo, hi);
+        }
+        nodeCount -= sizeOf(middle);
+        return TreapSet(middle);
+    }
 };
 
 // --- Ejemplo de Uso ---
@@ -262,5 +456,19 @@ int main() {
     cout << "member(30)? " << (miSet.member(30) ? "Si" : "No") << endl;
     cout << "size() despues de remover: " << miSet.size() << endl;
 
+    // Operaciones por rango
+    for (int i = 0; i < 100; i++) {
+        miSet.insert(i);
+    }
+    cout << "Insertando 0..99, size(): " << miSet.size() << endl;
+
+    TreapSet extraido = miSet.extract_range(10, 20);
+    cout << "extract_range(10, 20) -> size(): " << extraido.size()
+         << ", quedan: " << miSet.size() << endl;
+
+    miSet.erase_range(40, 60);
+    cout << "erase_range(40, 60) -> size(): " << miSet.size() << endl;
+    cout << "member(50)? " << (miSet.member(50) ? "Si" : "No") << endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,475 @@
+#include <iostream>
+#include <string>        // Para usar std::string
+#include <string_view>   // Para mirar llaves sin copiarlas
+#include <unordered_map> // Para la tabla de internado
+#include <vector>        // Para los bloques del arena
+#include <cstring>       // Para memcmp() y memcpy()
+#include <cstdint>       // Para uint64_t
+#include <cstdlib>       // Para rand() y srand()
+#include <ctime>         // Para time()
+
+using namespace std;
+
+typedef string Value;
+
+/**
+ * @brief Arena para guardar los bytes de las llaves.
+ * Reserva bloques grandes y va entregando pedazos de forma contigua,
+ * en vez de un 'new' por cada llave. No libera llaves sueltas: para
+ * recuperar memoria se arma un arena nuevo y se cambia con swap()
+ * (ver TreapStringMap::compact()).
+ */
+class KeyArena {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+    vector<char*> blocks;
+    char* current;    // Bloque del que se están entregando pedazos
+    size_t used;      // Bytes usados de 'current'
+    size_t reserved;  // Bytes totales reservados
+
+public:
+    KeyArena() {
+        current = nullptr;
+        used = 0;
+        reserved = 0;
+    }
+
+    ~KeyArena() {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            delete[] blocks[i];
+        }
+    }
+
+    // Copia 'text' dentro del arena y retorna un puntero estable
+    const char* store(string_view text) {
+        size_t n = text.size();
+        if (n == 0) {
+            return ""; // La llave vacía no ocupa bytes
+        }
+        if (n > BLOCK_SIZE / 4) {
+            // Llave muy grande: bloque propio, sin desperdiciar el actual
+            char* big = new char[n];
+            memcpy(big, text.data(), n);
+            blocks.push_back(big);
+            reserved += n;
+            return big;
+        }
+        if (current == nullptr || used + n > BLOCK_SIZE) {
+            current = new char[BLOCK_SIZE];
+            blocks.push_back(current);
+            used = 0;
+            reserved += BLOCK_SIZE;
+        }
+        char* out = current + used;
+        memcpy(out, text.data(), n);
+        used += n;
+        return out;
+    }
+
+    // Intercambia el contenido con otro arena (para compactar)
+    void swap(KeyArena& other) {
+        blocks.swap(other.blocks);
+        std::swap(current, other.current);
+        std::swap(used, other.used);
+        std::swap(reserved, other.reserved);
+    }
+
+    size_t bytesReserved() {
+        return reserved;
+    }
+};
+
+/**
+ * @brief Llave de texto lista para comparar rápido.
+ * 'prefix' son los 8 bytes que siguen a los 'skip' bytes que todas las
+ * llaves del mapa comparten (ej. "https://curso.edu/"), en orden
+ * big-endian y rellenos con 0. Así comparar dos prefijos como enteros
+ * equivale a comparar las llaves como texto, y el prefijo sí distingue
+ * llaves que empiezan igual.
+ */
+struct StringKey {
+    uint64_t prefix;
+    const char* data;
+    uint32_t length;
+
+    static uint64_t makePrefix(string_view text, size_t skip) {
+        uint64_t p = 0;
+        for (size_t i = skip; i < skip + 8; i++) {
+            unsigned char c = i < text.size() ? (unsigned char)text[i] : 0;
+            p = (p << 8) | c;
+        }
+        return p;
+    }
+
+    static StringKey make(string_view text, size_t skip) {
+        StringKey k;
+        k.prefix = makePrefix(text, skip);
+        k.data = text.data();
+        k.length = (uint32_t)text.size();
+        return k;
+    }
+};
+
+/**
+ * @brief Nodo para el TreapStringMap.
+ * El prefijo va primero: en la mayoría de comparaciones no hace falta
+ * salir del nodo para leer los bytes de la llave.
+ */
+struct Node {
+    StringKey key;   // Prefijo + puntero a los bytes internados
+    Value value;
+    int priority;
+    Node *left, *right;
+
+    // Constructor: asigna llave, valor y prioridad aleatoria
+    Node(StringKey k, Value v) {
+        key = k;
+        value = v;
+        priority = rand();
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+/**
+ * @brief TreapMap con llaves std::string.
+ * - Todas las llaves del mapa comparten sus primeros 'sharedPrefix' bytes;
+ *   el nodo guarda como entero los 8 bytes siguientes y se compara eso primero.
+ *   Si una llave nueva acorta el prefijo común, se recalculan los prefijos
+ *   de todos los nodos (O(n), y el prefijo común solo puede acortarse).
+ * - Solo si los prefijos empatan lee el resto de la llave (memcmp).
+ * - Las llaves se internan: cada texto distinto se guarda una sola vez
+ *   en un arena compartido, aunque se inserte y remueva muchas veces.
+ *   Las llaves removidas siguen ocupando el arena hasta compact(), que
+ *   se llama solo cuando lo internado llega al doble de lo vivo.
+ */
+class TreapStringMap {
+private:
+    Node* root;     // Raíz del árbol
+    int nodeCount;  // Cantidad de llaves en el mapa
+
+    KeyArena arena;                                   // Bytes de las llaves
+    unordered_map<string_view, const char*> interned; // Texto -> copia en arena
+    size_t internedBytes; // Bytes de todas las llaves internadas
+    size_t liveBytes;     // Bytes de las llaves que están en el árbol
+
+    string sharedPrefix;  // Bytes iniciales comunes a todas las llaves del árbol
+
+    /**
+     * @brief Compara dos llaves: < 0, 0 o > 0 como strcmp.
+     * Ambas comparten los primeros 'skip' bytes. Si los prefijos (enteros)
+     * difieren, ya está decidido. Si empatan, los primeros min(skip + 8, largo)
+     * bytes son iguales: falta el resto y el largo.
+     */
+    static int compare(const StringKey& a, const StringKey& b, size_t skip) {
+        if (a.prefix != b.prefix) {
+            return a.prefix < b.prefix ? -1 : 1;
+        }
+        if (a.data == b.data && a.length == b.length) {
+            return 0; // Misma llave internada
+        }
+        uint32_t common = a.length < b.length ? a.length : b.length;
+        if (common > skip + 8) {
+            int c = memcmp(a.data + skip + 8, b.data + skip + 8, common - skip - 8);
+            if (c != 0) {
+                return c;
+            }
+        }
+        if (a.length == b.length) return 0;
+        return a.length < b.length ? -1 : 1;
+    }
+
+    int compare(const StringKey& a, const StringKey& b) const {
+        return compare(a, b, sharedPrefix.size());
+    }
+
+    // Retorna la copia única (internada) del texto, creándola si no existe
+    string_view intern(string_view text) {
+        unordered_map<string_view, const char*>::iterator it = interned.find(text);
+        const char* stored;
+        if (it != interned.end()) {
+            stored = it->second;
+        } else {
+            stored = arena.store(text);
+            interned[string_view(stored, text.size())] = stored;
+            internedBytes += text.size();
+        }
+        return string_view(stored, text.size());
+    }
+
+    // ¿La llave consultada comparte el prefijo común? Si no, no está en el árbol
+    bool sharesPrefix(string_view text) const {
+        return text.size() >= sharedPrefix.size()
+            && memcmp(text.data(), sharedPrefix.data(), sharedPrefix.size()) == 0;
+    }
+
+    // Recalcula los prefijos de los nodos tras acortar 'sharedPrefix'
+    void refreshPrefixes(Node* node) {
+        if (node != nullptr) {
+            node->key = StringKey::make(string_view(node->key.data, node->key.length), sharedPrefix.size());
+            refreshPrefixes(node->left);
+            refreshPrefixes(node->right);
+        }
+    }
+
+    // Acorta el prefijo común para que 'text' también lo comparta
+    void widenFor(string_view text) {
+        if (root == nullptr) {
+            sharedPrefix.assign(text.data(), text.size());
+            return;
+        }
+        size_t m = 0;
+        while (m < sharedPrefix.size() && m < text.size() && sharedPrefix[m] == text[m]) {
+            m++;
+        }
+        if (m < sharedPrefix.size()) {
+            sharedPrefix.resize(m);
+            refreshPrefixes(root);
+        }
+    }
+
+    // Vuelve a internar las llaves vivas en un arena nuevo
+    void reinternRecursive(Node* node, KeyArena& fresh, unordered_map<string_view, const char*>& table) {
+        if (node != nullptr) {
+            string_view text(node->key.data, node->key.length);
+            const char* stored = fresh.store(text);
+            table[string_view(stored, text.size())] = stored;
+            node->key.data = stored;
+            reinternRecursive(node->left, fresh, table);
+            reinternRecursive(node->right, fresh, table);
+        }
+    }
+
+    // --- Funciones de Rotación ---
+    // Idénticas a las de TreapSet.
+
+    Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        Node* T2 = x->right;
+        x->right = y;
+        y->left = T2;
+        return x;
+    }
+
+    Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        Node* T2 = y->left;
+        y->left = x;
+        x->right = T2;
+        return y;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Ayudante recursivo para insertar (llave, valor).
+     * 'key' ya viene internada (ver insert()).
+     */
+    Node* insertRecursive(Node* node, const StringKey& key, const Value& value) {
+        if (node == nullptr) {
+            nodeCount++;
+            liveBytes += key.length;
+            return new Node(key, value);
+        }
+
+        int c = compare(key, node->key);
+        if (c < 0) {
+            node->left = insertRecursive(node->left, key, value);
+            if (node->left->priority > node->priority) {
+                node = rotateRight(node);
+            }
+        } else if (c > 0) {
+            node->right = insertRecursive(node->right, key, value);
+            if (node->right->priority > node->priority) {
+                node = rotateLeft(node);
+            }
+        } else {
+            // Llave encontrada: actualizar el valor
+            node->value = value;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para eliminar (por llave).
+     * Lógica idéntica a TreapMap. Los bytes de la llave quedan internados
+     * hasta el siguiente compact().
+     */
+    Node* removeRecursive(Node* node, const StringKey& key) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        int c = compare(key, node->key);
+        if (c < 0) {
+            node->left = removeRecursive(node->left, key);
+        } else if (c > 0) {
+            node->right = removeRecursive(node->right, key);
+        } else {
+            if (node->left == nullptr) {
+                Node* temp = node->right;
+                liveBytes -= node->key.length;
+                delete node;
+                nodeCount--;
+                return temp;
+            } else if (node->right == nullptr) {
+                Node* temp = node->left;
+                liveBytes -= node->key.length;
+                delete node;
+                nodeCount--;
+                return temp;
+            }
+
+            // 2 hijos: rotar
+            if (node->left->priority > node->right->priority) {
+                node = rotateRight(node);
+                node->right = removeRecursive(node->right, key);
+            } else {
+                node = rotateLeft(node);
+                node->left = removeRecursive(node->left, key);
+            }
+        }
+        return node;
+    }
+
+    // Búsqueda iterativa: la llave consultada no se interna
+    Node* findNode(string_view text) {
+        if (!sharesPrefix(text)) {
+            return nullptr;
+        }
+        StringKey key = StringKey::make(text, sharedPrefix.size());
+        Node* node = root;
+        while (node != nullptr) {
+            int c = compare(key, node->key);
+            if (c == 0) {
+                return node;
+            }
+            node = c < 0 ? node->left : node->right;
+        }
+        return nullptr;
+    }
+
+    // Libera toda la memoria de los nodos (el arena se libera solo)
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de un mapa vacío
+    TreapStringMap() {
+        root = nullptr;
+        nodeCount = 0;
+        internedBytes = 0;
+        liveBytes = 0;
+    }
+
+    // Destructor
+    ~TreapStringMap() {
+        clear();
+    }
+
+    // Vacía el mapa y libera también el arena de llaves
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+        liveBytes = 0;
+        compact();
+    }
+
+    /**
+     * @brief Libera las llaves internadas que ya no están en el árbol.
+     * Copia las llaves vivas a un arena nuevo y suelta el viejo: O(n).
+     */
+    void compact() {
+        KeyArena fresh;
+        unordered_map<string_view, const char*> table;
+        reinternRecursive(root, fresh, table);
+        arena.swap(fresh);
+        interned.swap(table);
+        internedBytes = liveBytes;
+    }
+
+    int size() {
+        return nodeCount;
+    }
+
+    // Cantidad de textos distintos guardados en el arena
+    int internedKeys() {
+        return (int)interned.size();
+    }
+
+    // Bytes reservados por el arena de llaves
+    size_t arenaBytes() {
+        return arena.bytesReserved();
+    }
+
+    // Inserta una llave y su respectivo dato
+    void insert(const string& key, Value value) {
+        string_view stored = intern(key);
+        widenFor(stored);
+        root = insertRecursive(root, StringKey::make(stored, sharedPrefix.size()), value);
+    }
+
+    // Elimina de la estructura la llave y su elemento asociado
+    void remove(const string& key) {
+        if (!sharesPrefix(key)) {
+            return;
+        }
+        root = removeRecursive(root, StringKey::make(key, sharedPrefix.size()));
+        // Mucha basura en el arena: compactar (amortizado O(1) por remove)
+        if (internedBytes > 2 * liveBytes + 64 * 1024) {
+            compact();
+        }
+    }
+
+    // Retorna el valor asociado o 'defaultValue' si no se encuentra
+    Value find(const string& key, Value defaultValue) {
+        Node* result = findNode(key);
+        if (result == nullptr) {
+            return defaultValue;
+        }
+        return result->value;
+    }
+
+    bool contains(const string& key) {
+        return findNode(key) != nullptr;
+    }
+};
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de TreapStringMap (string -> string) ---" << endl;
+    TreapStringMap rutas;
+
+    // insert: llaves tipo URL que comparten mucho prefijo
+    rutas.insert("https://curso.edu/treap", "Treap");
+    rutas.insert("https://curso.edu/heap", "Heap");
+    rutas.insert("https://curso.edu/bst", "BST");
+    rutas.insert("/", "Inicio");
+    rutas.insert("", "Vacía");
+
+    cout << "Insertando 5 rutas (incluida la vacía)..." << endl;
+    cout << "find(''): " << rutas.find("", "N/A") << endl;
+
+    // find
+    cout << "find(/heap): " << rutas.find("https://curso.edu/heap", "N/A") << endl;
+    cout << "find(/avl): " << rutas.find("https://curso.edu/avl", "N/A") << endl;
+
+    // remove + reinsertar: la llave ya está internada
+    rutas.remove("https://curso.edu/bst");
+    cout << "remove(/bst)... contains? "
+         << (rutas.contains("https://curso.edu/bst") ? "Si" : "No") << endl;
+    rutas.insert("https://curso.edu/bst", "BST v2");
+    cout << "Reinsertando /bst -> size(): " << rutas.size()
+         << ", llaves internadas: " << rutas.internedKeys() << endl;
+
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <iostream>
+#include <string>  // Para usar std::string
+#include <cstdlib> // Para rand() y srand()
+#include <ctime>   // Para time()
+
+using namespace std;
+
+// Para esta versión simple, definimos los tipos de llave y valor
+// en lugar de usar templates (igual que en TreapMap).
+typedef int Key;
+typedef string Value;
+
+/**
+ * @brief Nodo para el ZipMap.
+ * Almacena llave, valor asociado y un rango geométrico (ver ZipSet).
+ */
+struct Node {
+    Key key;
+    Value value;
+    unsigned char rank;
+    Node *left, *right;
+
+    // Constructor: asigna llave, valor y rango aleatorio
+    Node(Key k, Value v) {
+        key = k;
+        value = v;
+        rank = randomRank();
+        left = nullptr;
+        right = nullptr;
+    }
+
+    // Lanza monedas hasta sacar "sello": P(rank = r) = 1 / 2^(r+1)
+    static unsigned char randomRank() {
+        unsigned char r = 0;
+        while (r < 255 && (rand() & 1)) {
+            r++;
+        }
+        return r;
+    }
+};
+
+/**
+ * @brief Implementa el concepto de Asociación (Mapa) usando un Zip Tree.
+ * Misma interfaz que TreapMap; inserta con unzip y borra con zip
+ * en vez de rotar nivel por nivel (ver ZipSet).
+ */
+class ZipMap {
+private:
+    Node* root;      // Raíz del árbol
+    int nodeCount;   // Cantidad de llaves
+
+    // Inserción por unzip, idéntica a la de ZipSet
+    void insertNode(Node* x) {
+        // 1. Bajar por (rango, llave) hasta el lugar de 'x'
+        Node** link = &root;
+        while (*link != nullptr && ((*link)->rank > x->rank ||
+               ((*link)->rank == x->rank && (*link)->key < x->key))) {
+            link = (x->key < (*link)->key) ? &(*link)->left : &(*link)->right;
+        }
+        Node* cur = *link;
+        *link = x;
+
+        // 2. Unzip: el resto del camino se reparte entre la espina derecha
+        // de x->left (llaves menores) y la izquierda de x->right (mayores)
+        Node** lowHook = &x->left;
+        Node** highHook = &x->right;
+        while (cur != nullptr) {
+            Node* last;
+            if (cur->key < x->key) {
+                *lowHook = cur;
+                do {
+                    last = cur;
+                    cur = cur->right;
+                } while (cur != nullptr && cur->key < x->key);
+                lowHook = &last->right;
+            } else {
+                *highHook = cur;
+                do {
+                    last = cur;
+                    cur = cur->left;
+                } while (cur != nullptr && cur->key > x->key);
+                highHook = &last->left;
+            }
+        }
+        *lowHook = nullptr;
+        *highHook = nullptr;
+    }
+
+    // --- Funciones Recursivas ---
+    // Idénticas a las de ZipSet.
+
+    Node* zip(Node* x, Node* y) {
+        if (x == nullptr) return y;
+        if (y == nullptr) return x;
+        if (x->rank < y->rank) {
+            y->left = zip(x, y->left);
+            return y;
+        } else {
+            x->right = zip(x->right, y);
+            return x;
+        }
+    }
+
+    Node* removeRecursive(Node* node, Key key) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+
+        if (key < node->key) {
+            Node* child = removeRecursive(node->left, key);
+            if (child != node->left) node->left = child;
+        } else if (key > node->key) {
+            Node* child = removeRecursive(node->right, key);
+            if (child != node->right) node->right = child;
+        } else {
+            Node* merged = zip(node->left, node->right);
+            delete node;
+            nodeCount--;
+            return merged;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para buscar un nodo por su llave.
+     * Retorna el nodo (o nullptr) para que find() pueda extraer el valor.
+     */
+    Node* findNode(Node* node, Key key) {
+        if (node == nullptr) {
+            return nullptr;
+        }
+        if (key == node->key) {
+            return node;
+        }
+        if (key < node->key) {
+            return findNode(node->left, key);
+        } else {
+            return findNode(node->right, key);
+        }
+    }
+
+    // Libera toda la memoria
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de un mapa vacío
+    ZipMap() {
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Destructor
+    ~ZipMap() {
+        clear();
+    }
+
+    // Vacía el mapa
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Retorna la cantidad de llaves del mapa
+    int size() {
+        return nodeCount;
+    }
+
+    // Inserta una llave y su respectivo dato (si ya existe, actualiza el valor)
+    void insert(Key key, Value value) {
+        Node* existing = findNode(root, key);
+        if (existing != nullptr) {
+            existing->value = value;
+            return;
+        }
+        insertNode(new Node(key, value));
+        nodeCount++;
+    }
+
+    // Elimina de la estructura la llave y su elemento asociado
+    void remove(Key key) {
+        root = removeRecursive(root, key);
+    }
+
+    /**
+     * @brief Recibe una llave y retorna el valor asociado
+     * o un valor por defecto si no se encuentra.
+     */
+    Value find(Key key, Value defaultValue) {
+        Node* result = findNode(root, key);
+        if (result == nullptr) {
+            return defaultValue;
+        }
+        return result->value;
+    }
+
+    bool contains(Key key) {
+        return findNode(root, key) != nullptr;
+    }
+};
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de ZipMap (int -> string) ---" << endl;
+    ZipMap miMapa;
+
+    // insert
+    miMapa.insert(50, "Alejandro");
+    miMapa.insert(30, "Beatriz");
+    miMapa.insert(70, "Carlos");
+
+    cout << "Insertando (50, A), (30, B), (70, C)..." << endl;
+
+    // find
+    cout << "find(30, 'N/A'): " << miMapa.find(30, "N/A") << endl;
+    cout << "find(99, 'N/A'): " << miMapa.find(99, "N/A") << endl;
+
+    // insert (actualizar)
+    miMapa.insert(50, "Ana");
+    cout << "Actualizando valor de 50 a 'Ana'..." << endl;
+    cout << "find(50, 'N/A'): " << miMapa.find(50, "N/A") << endl;
+
+    // remove
+    miMapa.remove(70);
+    cout << "remove(70)..." << endl;
+    cout << "contains(70)? " << (miMapa.contains(70) ? "Si" : "No") << endl;
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+#include <iostream>
+#include <cstdlib> // Para rand() y srand()
+#include <ctime>   // Para time()
+
+using namespace std;
+
+/**
+ * @brief Nodo para el ZipSet.
+ * En vez de una prioridad aleatoria grande, guarda un 'rank' geométrico:
+ * la cantidad de "caras" seguidas al lanzar una moneda (en promedio 1).
+ */
+struct Node {
+    int key;            // El elemento (llave del BST)
+    unsigned char rank; // Rango aleatorio (valor del MaxHeap)
+    Node *left, *right;
+
+    // Constructor: asigna la llave y un rango aleatorio
+    Node(int k) {
+        key = k;
+        rank = randomRank();
+        left = nullptr;
+        right = nullptr;
+    }
+
+    // Lanza monedas hasta sacar "sello": P(rank = r) = 1 / 2^(r+1)
+    static unsigned char randomRank() {
+        unsigned char r = 0;
+        while (r < 255 && (rand() & 1)) {
+            r++;
+        }
+        return r;
+    }
+};
+
+/**
+ * @brief Implementa el concepto de Conjunto (Set) usando un Zip Tree.
+ * Misma interfaz que TreapSet. El árbol es el mismo tipo de treap
+ * (BST por llave, MaxHeap por rango; empates: la llave menor queda arriba),
+ * pero insertar y borrar no rotan nivel por nivel:
+ * - insert cuelga el nodo nuevo en su lugar y "descomprime" (unzip)
+ *   en una sola pasada el camino que queda debajo.
+ * - remove "comprime" (zip) las dos ramas del nodo eliminado.
+ * Así solo se escribe un puntero donde el camino cambia de dirección,
+ * en vez de los de una rotación por cada nivel que sube el nodo.
+ */
+class ZipSet {
+private:
+    Node* root;      // Raíz del árbol
+    int nodeCount;   // Contador para la cardinalidad
+
+    /**
+     * @brief Inserta el nodo 'x' (su llave no está en el árbol).
+     * Baja por rango hasta el primer nodo que 'x' debe tener debajo y
+     * cuelga 'x' en ese lugar. Luego recorre una sola vez el resto del
+     * camino (unzip): los tramos seguidos hacia el mismo lado quedan
+     * como estaban, y solo se escribe un puntero donde el camino cambia
+     * de dirección (más los dos extremos de las espinas).
+     */
+    void insertNode(Node* x) {
+        // 1. Bajar por (rango, llave) hasta el lugar de 'x'
+        Node** link = &root;
+        while (*link != nullptr && ((*link)->rank > x->rank ||
+               ((*link)->rank == x->rank && (*link)->key < x->key))) {
+            link = (x->key < (*link)->key) ? &(*link)->left : &(*link)->right;
+        }
+        Node* cur = *link;
+        *link = x;
+
+        // 2. Unzip: el resto del camino se reparte entre la espina derecha
+        // de x->left (llaves menores) y la izquierda de x->right (mayores)
+        Node** lowHook = &x->left;
+        Node** highHook = &x->right;
+        while (cur != nullptr) {
+            Node* last;
+            if (cur->key < x->key) {
+                *lowHook = cur;
+                do {
+                    last = cur;
+                    cur = cur->right;
+                } while (cur != nullptr && cur->key < x->key);
+                lowHook = &last->right;
+            } else {
+                *highHook = cur;
+                do {
+                    last = cur;
+                    cur = cur->left;
+                } while (cur != nullptr && cur->key > x->key);
+                highHook = &last->left;
+            }
+        }
+        *lowHook = nullptr;
+        *highHook = nullptr;
+    }
+
+    // --- Funciones Recursivas ---
+
+    /**
+     * @brief Une (zip) dos ramas: todas las llaves de 'x' son menores
+     * que las de 'y'. Va intercalando ambos caminos por rango.
+     */
+    Node* zip(Node* x, Node* y) {
+        if (x == nullptr) return y;
+        if (y == nullptr) return x;
+        if (x->rank < y->rank) {
+            y->left = zip(x, y->left);
+            return y;
+        } else {
+            x->right = zip(x->right, y);
+            return x;
+        }
+    }
+
+    /**
+     * @brief Ayudante recursivo para eliminar.
+     * Al encontrar el nodo, sus dos ramas se comprimen en una sola.
+     * El puntero del padre solo se reescribe si su hijo cambió.
+     */
+    Node* removeRecursive(Node* node, int key) {
+        if (node == nullptr) {
+            return nullptr; // No se encontró
+        }
+
+        if (key < node->key) {
+            Node* child = removeRecursive(node->left, key);
+            if (child != node->left) node->left = child;
+        } else if (key > node->key) {
+            Node* child = removeRecursive(node->right, key);
+            if (child != node->right) node->right = child;
+        } else {
+            Node* merged = zip(node->left, node->right);
+            delete node;
+            nodeCount--;
+            return merged;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ayudante recursivo para buscar (member).
+     * Es una búsqueda de BST estándar.
+     */
+    bool memberRecursive(Node* node, int key) {
+        if (node == nullptr) {
+            return false;
+        }
+        if (key == node->key) {
+            return true;
+        }
+        if (key < node->key) {
+            return memberRecursive(node->left, key);
+        } else {
+            return memberRecursive(node->right, key);
+        }
+    }
+
+    // Libera toda la memoria del árbol
+    void clearRecursive(Node* node) {
+        if (node != nullptr) {
+            clearRecursive(node->left);
+            clearRecursive(node->right);
+            delete node;
+        }
+    }
+
+public:
+    // Constructor de un conjunto vacío
+    ZipSet() {
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Destructor
+    ~ZipSet() {
+        clear();
+    }
+
+    // Vacía el árbol
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        nodeCount = 0;
+    }
+
+    // Retorna la cardinalidad del conjunto
+    int size() {
+        return nodeCount;
+    }
+
+    // Adiciona un elemento al conjunto
+    void insert(int key) {
+        // Solo insertamos si no es miembro, para no tener duplicados
+        if (!member(key)) {
+            insertNode(new Node(key));
+            nodeCount++;
+        }
+    }
+
+    // Retira un elemento del conjunto (si no está, no hace nada)
+    void remove(int key) {
+        root = removeRecursive(root, key);
+    }
+
+    // Retorna si éste hace parte del conjunto
+    bool member(int key) {
+        return memberRecursive(root, key);
+    }
+};
+
+// --- Ejemplo de Uso ---
+int main() {
+    // Inicializar la semilla aleatoria (importante para los rangos)
+    srand(time(NULL));
+
+    cout << "--- Ejemplo de ZipSet (Conjunto de ints) ---" << endl;
+    ZipSet miSet;
+
+    // insert
+    miSet.insert(50);
+    miSet.insert(30);
+    miSet.insert(70);
+    miSet.insert(20);
+
+    cout << "Insertando 50, 30, 70, 20..." << endl;
+
+    // member
+    cout << "member(30)? " << (miSet.member(30) ? "Si" : "No") << endl;
+    cout << "member(99)? " << (miSet.member(99) ? "Si" : "No") << endl;
+
+    // size
+    cout << "size(): " << miSet.size() << endl;
+
+    // remove
+    miSet.remove(30);
+    cout << "remove(30)..." << endl;
+    cout << "member(30)? " << (miSet.member(30) ? "Si" : "No") << endl;
+    cout << "size() despues de remover: " << miSet.size() << endl;
+
+    return 0;
+}